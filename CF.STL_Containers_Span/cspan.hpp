@@ -0,0 +1,114 @@
+//
+//  cspan.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/container/span
+//
+
+#ifndef cspan_hpp
+#define cspan_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+#include "cspan_instrument.hpp"
+#include "cspan_compare.hpp"
+#include "cspan_search.hpp"
+#include "cspan_multi_search.hpp"
+#include "cspan_window.hpp"
+#include "cspan_rolling.hpp"
+#include "cspan_algorithm.hpp"
+#include "cspan_filter.hpp"
+#include "cspan_format.hpp"
+#include "cspan_mapped.hpp"
+#include "cspan_stream.hpp"
+#include "cspan_parallel.hpp"
+#include "cspan_arena.hpp"
+#include "cspan_view_as.hpp"
+#include "cspan_strided.hpp"
+#include "cspan_soa.hpp"
+#include "cspan_hash.hpp"
+#include "cspan_pipeline.hpp"
+#include "cspan_ring.hpp"
+#include "cspan_inline_buffer.hpp"
+#include "cspan_static.hpp"
+#include "cspan_search_tree.hpp"
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+template<class T, std::size_t N>
+[[nodiscard]]
+constexpr auto slide(std::span<T, N> span, std::size_t offset, std::size_t width) {
+  CSPAN_PROBE(slide);
+  return span.subspan(offset, CSPAN_RESULT(offset + width <= span.size(), 0U) ? width : 0U);
+}
+
+//  Both extents static: a prefix/suffix longer than the data is rejected at
+//  compile time. At run time, scalar element types whose == is bitwise
+//  compare as bytes (see detail::equal_bytes); constant evaluation and
+//  all other types keep std::equal.
+template<class T, std::size_t N, std::size_t M>
+[[nodiscard]]
+constexpr bool starts_with(std::span<T, N> data, std::span<T, M> prefix) {
+  if constexpr (N != std::dynamic_extent && M != std::dynamic_extent && M > N) {
+    return false;
+  }
+  else {
+    CSPAN_PROBE(starts_with);
+    if (data.size() < prefix.size()) {
+      return CSPAN_RESULT(false, 0U);
+    }
+    if constexpr (detail::is_memcmp_comparable_v<T>) {
+      if (!std::is_constant_evaluated()) {
+        return CSPAN_RESULT(detail::equal_bytes(data.data(), prefix.data(), prefix.size_bytes()),
+                            prefix.size_bytes());
+      }
+    }
+    return CSPAN_RESULT(std::equal(prefix.begin(), prefix.end(), data.begin()), prefix.size_bytes());
+  }
+}
+
+template<class T, std::size_t N, std::size_t M>
+[[nodiscard]]
+constexpr bool ends_with(std::span<T, N> data, std::span<T, M> suffix) {
+  if constexpr (N != std::dynamic_extent && M != std::dynamic_extent && M > N) {
+    return false;
+  }
+  else {
+    CSPAN_PROBE(ends_with);
+    if (data.size() < suffix.size()) {
+      return CSPAN_RESULT(false, 0U);
+    }
+    if constexpr (detail::is_memcmp_comparable_v<T>) {
+      if (!std::is_constant_evaluated()) {
+        return CSPAN_RESULT(detail::equal_bytes(data.data() + (data.size() - suffix.size()),
+                                                suffix.data(), suffix.size_bytes()),
+                            suffix.size_bytes());
+      }
+    }
+    return CSPAN_RESULT(std::equal(data.end() - suffix.size(), data.end(),
+                                   suffix.end() - suffix.size()), suffix.size_bytes());
+  }
+}
+
+//  Runtime calls dispatch to the SIMD / Two-Way engine in cspan_search.hpp;
+//  constant evaluation keeps the plain std::search.
+template<class T, std::size_t N, std::size_t M>
+[[nodiscard]]
+constexpr bool contains(std::span<T, N> span, std::span<T, M> sub) {
+  CSPAN_PROBE(contains);
+  auto const found = detail::find(std::span<T const> { span }, std::span<T const> { sub });
+  //  Bytes scanned: up to the end of the match, or all of `span`.
+  return CSPAN_RESULT(found != span.size(),
+                      (found != span.size() ? found + sub.size() : span.size()) * sizeof(T));
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_hpp */
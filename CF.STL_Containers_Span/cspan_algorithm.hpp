@@ -0,0 +1,232 @@
+//
+//  cspan_algorithm.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/utility/integer_sequence
+//  @see: https://en.cppreference.com/w/cpp/language/fold
+//
+
+#ifndef cspan_algorithm_hpp
+#define cspan_algorithm_hpp
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "cspan_config.hpp"
+#include "cspan_compare.hpp"
+#include "cspan_reverse.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Static extents up to this size are expanded element by element
+//  (a fold over an index_sequence: straight-line code, no loop);
+//  larger static extents use the runtime loop with a constant trip count.
+inline constexpr std::size_t unroll_max { 16U };
+
+template<std::size_t N>
+inline constexpr bool unrolled_v = N != std::dynamic_extent && N <= unroll_max;
+
+//  Call fn(std::integral_constant<std::size_t, I>{}) for I in [0, N).
+template<std::size_t N, class Fn>
+CSPAN_ALWAYS_INLINE constexpr void unroll(Fn && fn) {
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    (fn(std::integral_constant<std::size_t, I> {}), ...);
+  }(std::make_index_sequence<N> {});
+}
+
+//  Independent accumulators for the runtime reductions: they break the
+//  loop-carried dependency that otherwise serialises sum / min_max.
+inline constexpr std::size_t lanes { 8U };
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+//  Each algorithm below takes std::span<T, N>: a static N <= 16 is fully
+//  unrolled at compile time, any other extent runs a tuned loop.
+
+//  MARK: fill()
+template<class T, std::size_t N, class V>
+constexpr void fill(std::span<T, N> span, V const & value) {
+  if constexpr (detail::unrolled_v<N>) {
+    detail::unroll<N>([&](auto ix) { span[ix] = value; });
+  }
+  else {
+    std::fill(span.begin(), span.end(), value);
+  }
+}
+
+//  MARK: copy()
+//  Copy src into the front of dst; returns the written part of dst.
+template<class T, std::size_t N, class U, std::size_t M>
+constexpr auto copy(std::span<T, N> src, std::span<U, M> dst) {
+  if constexpr (N != std::dynamic_extent) {
+    static_assert(M == std::dynamic_extent || M >= N, "destination too small");
+    assert(dst.size() >= N);
+    if constexpr (detail::unrolled_v<N>) {
+      detail::unroll<N>([&](auto ix) { dst[ix] = src[ix]; });
+    }
+    else {
+      std::copy(src.begin(), src.end(), dst.begin());
+    }
+    return std::span<U, N> { dst.data(), N };
+  }
+  else {
+    assert(dst.size() >= src.size());
+    std::copy(src.begin(), src.end(), dst.begin());
+    return std::span<U> { dst.data(), src.size() };
+  }
+}
+
+//  MARK: equal()
+//  Same size and element-wise equal.
+template<class T, std::size_t N, class U, std::size_t M>
+[[nodiscard]]
+constexpr bool equal(std::span<T, N> lhs, std::span<U, M> rhs) {
+  if constexpr (N != std::dynamic_extent && M != std::dynamic_extent && N != M) {
+    return false;
+  }
+  else if constexpr (detail::unrolled_v<N> && detail::unrolled_v<M>) {
+    auto same { true };
+    detail::unroll<N>([&](auto ix) { same = same & (lhs[ix] == rhs[ix]); });
+    return same;
+  }
+  else {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    if constexpr (std::is_same_v<std::remove_cv_t<T>, std::remove_cv_t<U>>
+                  && detail::is_memcmp_comparable_v<T>) {
+      if (!std::is_constant_evaluated()) {
+        return detail::equal_bytes(lhs.data(), rhs.data(), lhs.size_bytes());
+      }
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+}
+
+//  MARK: reverse()
+//  Scalar elements of 1, 2, 4 or 8 bytes are reversed a register at a time
+//  (see detail::reverse_run).
+template<class T, std::size_t N>
+constexpr void reverse(std::span<T, N> span) {
+  if constexpr (detail::unrolled_v<N>) {
+    detail::unroll<N / 2U>([&](auto ix) {
+      std::swap(span[ix], span[N - 1U - ix]);
+    });
+  }
+  else {
+    if (std::is_constant_evaluated()) {
+      std::reverse(span.begin(), span.end());
+    }
+    else {
+      detail::reverse_run(span.data(), span.size());
+    }
+  }
+}
+
+//  MARK: rotate()
+//  Left-rotate so that span[shift] becomes the first element, as
+//  std::rotate(begin, begin + shift, end); returns the new index of the
+//  old first element. Trivially copyable elements move through a stack
+//  buffer when the shorter side is small, else by three SIMD reversals.
+template<class T, std::size_t N>
+constexpr std::size_t rotate(std::span<T, N> span, std::size_t const shift) {
+  assert(shift <= span.size());
+  if (shift != 0U && shift != span.size()) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (!std::is_constant_evaluated()) {
+        detail::rotate_run(span.data(), span.size(), shift);
+        return span.size() - shift;
+      }
+    }
+    std::rotate(span.begin(), span.begin() + shift, span.end());
+  }
+  return span.size() - shift;
+}
+
+//  MARK: sum()
+//  Runtime loops use detail::lanes partial sums, so a floating-point result
+//  may differ from std::accumulate in the last bits.
+template<class T, std::size_t N, class R = std::remove_cv_t<T>>
+[[nodiscard]]
+constexpr R sum(std::span<T, N> span, R init = R {}) {
+  if constexpr (detail::unrolled_v<N>) {
+    detail::unroll<N>([&](auto ix) { init += static_cast<R>(span[ix]); });
+    return init;
+  }
+  else {
+    R part[detail::lanes] {};
+    std::size_t ix { 0U };
+    for (; ix + detail::lanes <= span.size(); ix += detail::lanes) {
+      detail::unroll<detail::lanes>([&](auto ln) {
+        part[ln] += static_cast<R>(span[ix + ln]);
+      });
+    }
+    for (; ix < span.size(); ++ix) {
+      part[0] += static_cast<R>(span[ix]);
+    }
+    detail::unroll<detail::lanes>([&](auto ln) { init += part[ln]; });
+    return init;
+  }
+}
+
+//  MARK: min_max()
+template<class T>
+struct min_max_result {
+  T min;
+  T max;
+};
+
+//  Smallest and largest element of a non-empty span.
+template<class T, std::size_t N>
+[[nodiscard]]
+constexpr auto min_max(std::span<T, N> span) {
+  using value_type = std::remove_cv_t<T>;
+  static_assert(N != 0U, "min_max of an empty span");
+  assert(!span.empty());
+
+  auto lo = static_cast<value_type>(span[0]);
+  auto hi = lo;
+  if constexpr (detail::unrolled_v<N>) {
+    detail::unroll<N>([&](auto ix) {
+      lo = span[ix] < lo ? span[ix] : lo;
+      hi = hi < span[ix] ? span[ix] : hi;
+    });
+  }
+  else {
+    value_type los[detail::lanes];
+    value_type his[detail::lanes];
+    std::fill(std::begin(los), std::end(los), lo);
+    std::fill(std::begin(his), std::end(his), hi);
+    std::size_t ix { 0U };
+    for (; ix + detail::lanes <= span.size(); ix += detail::lanes) {
+      detail::unroll<detail::lanes>([&](auto ln) {
+        auto const val = span[ix + ln];
+        los[ln] = val < los[ln] ? val : los[ln];
+        his[ln] = his[ln] < val ? val : his[ln];
+      });
+    }
+    for (; ix < span.size(); ++ix) {
+      lo = span[ix] < lo ? span[ix] : lo;
+      hi = hi < span[ix] ? span[ix] : hi;
+    }
+    detail::unroll<detail::lanes>([&](auto ln) {
+      lo = los[ln] < lo ? los[ln] : lo;
+      hi = hi < his[ln] ? his[ln] : hi;
+    });
+  }
+  return min_max_result<value_type> { lo, hi };
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_algorithm_hpp */
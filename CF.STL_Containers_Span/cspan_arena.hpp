@@ -0,0 +1,245 @@
+//
+//  cspan_arena.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Region-based_memory_management
+//  @see: https://en.cppreference.com/w/cpp/memory/monotonic_buffer_resource
+//
+
+#ifndef cspan_arena_hpp
+#define cspan_arena_hpp
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#if (__has_include(<memory_resource>))
+#include <memory_resource>
+#endif  /* (__has_include(<memory_resource>)) */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: arena
+ *  Bump allocator over a chain of blocks: an optional caller-provided
+ *  buffer first, then blocks from operator new. Allocation is a pointer
+ *  bump; nothing is freed one at a time. rewind() / reset() return memory
+ *  for reuse without giving blocks back, release() gives them back.
+ *  Objects placed in the arena are never destroyed, so only trivially
+ *  destructible types are accepted. Not thread-safe: one arena per thread
+ *  (see thread_arena()).
+ */
+class arena {
+  struct block {
+    block * next;
+    std::byte * begin;
+    std::byte * end;
+  };
+
+public:
+  //  A position to rewind() to: everything allocated after it is reused.
+  struct marker {
+    block * current;
+    std::byte * ptr;
+  };
+
+  static std::size_t constexpr default_block { 64U << 10U };
+
+  explicit arena(std::size_t const block_size = default_block) noexcept
+    : block_size_ { block_size } {}
+
+  //  Serve allocations from `initial` until it is full.
+  explicit arena(std::span<std::byte> const initial, std::size_t const block_size = default_block) noexcept
+    : block_size_ { block_size },
+      first_ { nullptr, initial.data(), initial.data() + initial.size() },
+      head_ { &first_ }, current_ { &first_ }, ptr_ { first_.begin } {}
+
+  arena(arena const &) = delete;
+  arena & operator=(arena const &) = delete;
+
+  ~arena() { release(); }
+
+  //  Raw storage; `align` must be a power of two.
+  [[nodiscard]]
+  void * allocate(std::size_t const bytes, std::size_t const align = alignof(std::max_align_t)) {
+    assert(std::has_single_bit(align));
+    if (current_ != nullptr) {
+      auto const at = align_up(ptr_, align);
+      if (at <= current_->end && static_cast<std::size_t>(current_->end - at) >= bytes) {
+        ptr_ = at + bytes;
+        return at;
+      }
+    }
+    return allocate_slow(bytes, align);
+  }
+
+  //  `count` default-initialised T, aligned to max(align, alignof(T)).
+  template<class T>
+  [[nodiscard]]
+  std::span<T> allocate_span(std::size_t const count, std::size_t const align = alignof(T)) {
+    static_assert(std::is_trivially_destructible_v<T>, "arena never runs destructors");
+    auto const data = static_cast<T *>(allocate(count * sizeof(T), std::max(align, alignof(T))));
+    std::uninitialized_default_construct_n(data, count);
+    return { data, count };
+  }
+
+  //  A copy of `src` in the arena.
+  template<class T, std::size_t N>
+  [[nodiscard]]
+  std::span<std::remove_cv_t<T>> copy_span(std::span<T, N> const src) {
+    using U = std::remove_cv_t<T>;
+    static_assert(std::is_trivially_destructible_v<U>, "arena never runs destructors");
+    auto const data = static_cast<U *>(allocate(src.size_bytes(), alignof(U)));
+    std::uninitialized_copy(src.begin(), src.end(), data);
+    return { data, src.size() };
+  }
+
+  [[nodiscard]]
+  marker mark() const noexcept { return { current_, ptr_ }; }
+
+  void rewind(marker const where) noexcept {
+    current_ = where.current;
+    ptr_ = where.ptr;
+    if (current_ == nullptr) {
+      reset();
+    }
+  }
+
+  //  Reuse everything; blocks are kept.
+  void reset() noexcept {
+    current_ = head_;
+    ptr_ = head_ != nullptr ? head_->begin : nullptr;
+  }
+
+  //  Reuse everything and return the blocks to operator new.
+  void release() noexcept {
+    for (auto blk = head_ == &first_ ? first_.next : head_; blk != nullptr; ) {
+      auto const next = blk->next;
+      ::operator delete(static_cast<void *>(blk));
+      blk = next;
+    }
+    first_.next = nullptr;
+    head_ = first_.begin != nullptr ? &first_ : nullptr;
+    reset();
+  }
+
+  //  Bytes in all blocks, the initial buffer included.
+  [[nodiscard]]
+  std::size_t capacity() const noexcept {
+    std::size_t total { 0U };
+    for (auto blk = head_; blk != nullptr; blk = blk->next) {
+      total += static_cast<std::size_t>(blk->end - blk->begin);
+    }
+    return total;
+  }
+
+private:
+  [[nodiscard]]
+  static std::byte * align_up(std::byte * const ptr, std::size_t const align) noexcept {
+    auto const addr = reinterpret_cast<std::uintptr_t>(ptr);
+    return ptr + ((align - addr % align) % align);
+  }
+
+  //  Move on to the next kept block that fits, else chain a new one.
+  void * allocate_slow(std::size_t const bytes, std::size_t const align) {
+    auto last = current_;
+    for (auto blk = current_ != nullptr ? current_->next : head_; blk != nullptr; blk = blk->next) {
+      auto const at = align_up(blk->begin, align);
+      if (at <= blk->end && static_cast<std::size_t>(blk->end - at) >= bytes) {
+        current_ = blk;
+        ptr_ = at + bytes;
+        return at;
+      }
+      last = blk;
+    }
+
+    auto const header = (sizeof(block) + alignof(std::max_align_t) - 1U)
+      / alignof(std::max_align_t) * alignof(std::max_align_t);
+    auto const size = std::max(block_size_, bytes + align);
+    auto const raw = static_cast<std::byte *>(::operator new(header + size));
+    auto const blk = ::new (static_cast<void *>(raw)) block { nullptr, raw + header, raw + header + size };
+    if (last != nullptr) {
+      blk->next = last->next;
+      last->next = blk;
+    }
+    else {
+      head_ = blk;
+    }
+    current_ = blk;
+    auto const at = align_up(blk->begin, align);
+    ptr_ = at + bytes;
+    return at;
+  }
+
+  std::size_t block_size_;
+  block first_ { nullptr, nullptr, nullptr };
+  block * head_ { nullptr };
+  block * current_ { nullptr };
+  std::byte * ptr_ { nullptr };
+};
+
+/*
+ *  MARK: arena_scope
+ *  Rewinds its arena on destruction: per-request scratch memory.
+ */
+class arena_scope {
+public:
+  explicit arena_scope(arena & owner) noexcept
+    : arena_ { owner }, mark_ { owner.mark() } {}
+
+  arena_scope(arena_scope const &) = delete;
+  arena_scope & operator=(arena_scope const &) = delete;
+
+  ~arena_scope() { arena_.rewind(mark_); }
+
+private:
+  arena & arena_;
+  arena::marker mark_;
+};
+
+//  MARK: thread_arena()
+//  A per-thread arena, created on first use in each thread.
+[[nodiscard]]
+inline arena & thread_arena() {
+  thread_local arena local;
+  return local;
+}
+
+#if (defined(__cpp_lib_memory_resource))
+/*
+ *  MARK: arena_resource
+ *  std::pmr::memory_resource over an arena, for pmr containers:
+ *  deallocate is a no-op, memory returns with the arena's rewind / reset.
+ */
+class arena_resource final : public std::pmr::memory_resource {
+public:
+  explicit arena_resource(arena & owner) noexcept : arena_ { &owner } {}
+
+private:
+  void * do_allocate(std::size_t const bytes, std::size_t const align) override {
+    return arena_->allocate(bytes, align);
+  }
+
+  void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+  [[nodiscard]]
+  bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override {
+    auto const that = dynamic_cast<arena_resource const *>(&other);
+    return that != nullptr && that->arena_ == arena_;
+  }
+
+  arena * arena_;
+};
+#endif  /* (defined(__cpp_lib_memory_resource)) */
+
+} /* namespace cspan */
+
+#endif /* cspan_arena_hpp */
@@ -0,0 +1,1520 @@
+//
+//  cspan_bench.cpp
+//  CF.STL_Containers_Span
+//
+//  Micro-benchmarks for the cspan algorithms.
+//
+//  Build (the cspan_bench target of the top-level CMakeLists.txt, or from
+//  this directory):
+//    c++ -std=c++20 -O2 -I. cspan_bench.cpp -o cspan_bench
+//  Run all benchmarks, or only those whose name contains the argument:
+//    ./cspan_bench [--json | --csv] [filter]
+//  The core benchmarks (slide ... as_bytes) also record ns/element, GB/s
+//  and cycles/element per element type and input size; --json / --csv
+//  write those records to stdout, for comparing runs between versions,
+//  and send the tables to stderr.
+//
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <span>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "cspan.hpp"
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Allocation counting
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+//  Every operator new in the program is counted (the array and nothrow
+//  forms forward here), for bench_inline_buffer.
+namespace bench {
+
+inline std::atomic<std::size_t> allocations { 0U };
+
+} /* namespace bench */
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif  /* (defined(__GNUC__) && !defined(__clang__)) */
+void * operator new(std::size_t const bytes) {
+  bench::allocations.fetch_add(1U, std::memory_order_relaxed);
+  if (auto * const ptr = std::malloc(bytes == 0U ? 1U : bytes)) {
+    return ptr;
+  }
+  throw std::bad_alloc {};
+}
+
+void operator delete(void * const ptr) noexcept { std::free(ptr); }
+void operator delete(void * const ptr, std::size_t) noexcept { std::free(ptr); }
+#if (defined(__GNUC__) && !defined(__clang__))
+#pragma GCC diagnostic pop
+#endif  /* (defined(__GNUC__) && !defined(__clang__)) */
+
+//  MARK: - namespace bench
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+//  Keep `value` alive without letting the optimiser see through it.
+template<class T>
+inline void keep(T const & value) {
+#if (defined(__GNUC__) || defined(__clang__))
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*static_cast<T const volatile *>(&value));
+#endif  /* (defined(__GNUC__) || defined(__clang__)) */
+}
+
+//  Best wall-clock time of `reps` runs, in nanoseconds.
+template<class Fn>
+[[nodiscard]]
+double best_ns(Fn && fn, int const reps = 5) {
+  auto best { std::chrono::nanoseconds::max() };
+  for (int rep { 0 }; rep != reps; ++rep) {
+    auto const start = clock::now();
+    fn();
+    best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start));
+  }
+  return static_cast<double>(best.count());
+}
+
+//  Time-stamp counter, where there is one: it ticks at the nominal clock
+//  rate, so "cycles" are reference cycles, not core cycles under turbo.
+[[nodiscard]]
+inline std::uint64_t cycles() noexcept {
+#if (CSPAN_X86)
+  return __rdtsc();
+#else
+  return 0U;
+#endif  /* (CSPAN_X86) */
+}
+
+inline constexpr bool has_cycles { CSPAN_X86 != 0 };
+
+struct sample {
+  double ns;
+  double cycles;
+};
+
+//  Cost of one call of `fn`: the best of `reps` runs, each of enough calls
+//  to take about 2 ms, so short calls are not lost in the clock's overhead.
+template<class Fn>
+[[nodiscard]]
+sample per_call(Fn && fn, int const reps = 5) {
+  std::size_t calls { 1U };
+  for (;;) {
+    auto const start = clock::now();
+    for (std::size_t ix { 0U }; ix != calls; ++ix) {
+      fn();
+    }
+    if (clock::now() - start >= std::chrono::milliseconds { 2 } || calls >= (1U << 24U)) {
+      break;
+    }
+    calls *= 2U;
+  }
+
+  sample best { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+  for (int rep { 0 }; rep != reps; ++rep) {
+    auto const start = clock::now();
+    auto const tsc = cycles();
+    for (std::size_t ix { 0U }; ix != calls; ++ix) {
+      fn();
+    }
+    auto const ticks = static_cast<double>(cycles() - tsc);
+    auto const ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    if (ns < best.ns) {
+      best = { ns, ticks };
+    }
+  }
+  auto const count = static_cast<double>(calls);
+  return { best.ns / count, best.cycles / count };
+}
+
+/*
+ *  MARK: result
+ *  One row of the machine-readable report. `bytes` is what one call reads
+ *  (or writes), for GB/s.
+ */
+struct result {
+  std::string_view benchmark;
+  std::string_view type;
+  std::size_t elements;
+  double ns_per_element;
+  double gb_per_s;
+  double cycles_per_element;
+};
+
+[[nodiscard]]
+inline std::vector<result> & results() {
+  static std::vector<result> all;
+  return all;
+}
+
+//  Record one measurement and print it as a table row.
+inline void record(std::string_view const benchmark, std::string_view const type,
+                   std::size_t const elements, std::size_t const bytes, sample const & cost) {
+  auto const count = static_cast<double>(elements);
+  result const row {
+    benchmark, type, elements,
+    cost.ns / count,
+    static_cast<double>(bytes) / cost.ns,
+    has_cycles ? cost.cycles / count : 0.0,
+  };
+  results().push_back(row);
+
+  std::cout << std::fixed << std::setprecision(3)
+            << std::setw(10) << row.type
+            << std::setw(11) << row.elements
+            << std::setw(11) << row.ns_per_element
+            << std::setw(10) << row.gb_per_s
+            << std::setw(14) << row.cycles_per_element << '\n';
+}
+
+inline void table_header(std::string_view const benchmark, std::string_view const what) {
+  std::cout << benchmark << ": "s << what << '\n'
+            << "      type   elements    ns/elem      GB/s   cycles/elem\n"s;
+}
+
+template<class T> inline constexpr std::string_view type_name {};
+template<> inline constexpr std::string_view type_name<char> { "char" };
+template<> inline constexpr std::string_view type_name<std::uint8_t> { "uint8_t" };
+template<> inline constexpr std::string_view type_name<std::int32_t> { "int32_t" };
+template<> inline constexpr std::string_view type_name<std::int64_t> { "int64_t" };
+template<> inline constexpr std::string_view type_name<float> { "float" };
+template<> inline constexpr std::string_view type_name<double> { "double" };
+
+enum class output {
+  text,
+  json,
+  csv,
+};
+
+//  MARK: write_results()
+inline void write_results(std::ostream & out, output const format) {
+  auto const number = [&out](double const value) -> std::ostream & {
+    return out << std::defaultfloat << std::setprecision(6) << value;
+  };
+
+  if (format == output::csv) {
+    out << "benchmark,type,elements,ns_per_element,gb_per_s,cycles_per_element\n"s;
+    for (auto const & row : results()) {
+      out << row.benchmark << ',' << row.type << ',' << row.elements << ',';
+      number(row.ns_per_element) << ',';
+      number(row.gb_per_s) << ',';
+      if (has_cycles) {
+        number(row.cycles_per_element);
+      }
+      out << '\n';
+    }
+  }
+  else if (format == output::json) {
+    out << "{\n  \"cplusplus\": "s << __cplusplus
+        << ",\n  \"cycle_counter\": \""s << (has_cycles ? "tsc"s : "none"s)
+        << "\",\n  \"results\": ["s;
+    for (std::size_t ix { 0U }; ix != results().size(); ++ix) {
+      auto const & row = results()[ix];
+      out << (ix == 0U ? "\n"s : ",\n"s)
+          << "    { \"benchmark\": \""s << row.benchmark
+          << "\", \"type\": \""s << row.type
+          << "\", \"elements\": "s << row.elements
+          << ", \"ns_per_element\": "s;
+      number(row.ns_per_element) << ", \"gb_per_s\": "s;
+      number(row.gb_per_s) << ", \"cycles_per_element\": "s;
+      if (has_cycles) {
+        number(row.cycles_per_element);
+      }
+      else {
+        out << "null"s;
+      }
+      out << " }"s;
+    }
+    out << "\n  ]\n}\n"s;
+  }
+}
+
+[[nodiscard]]
+inline auto random_bytes(std::size_t const count, std::uint32_t const seed = 42U) {
+  std::mt19937 rng { seed };
+  std::vector<unsigned char> bytes(count);
+  std::generate(bytes.begin(), bytes.end(), [&rng] {
+    return static_cast<unsigned char>(rng());
+  });
+  return bytes;
+}
+
+} /* namespace bench */
+
+//  MARK: - Benchmarks
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+/*
+ *  MARK: core
+ *  The cspan.hpp basics, and the two printing loops of the spans.cpp
+ *  demo, across element types and input sizes (in elements). Every row
+ *  is recorded for --json / --csv; "elements" is what one call visits.
+ */
+namespace core {
+
+std::size_t constexpr sizes[] { 64U, 4U << 10U, 256U << 10U, 4U << 20U, };
+std::size_t constexpr print_sizes[] { 64U, 4U << 10U, 256U << 10U, };
+
+//  Values 0 .. 99: a needle of values >= 100 never matches.
+template<class T>
+[[nodiscard]]
+std::vector<T> values(std::size_t const count) {
+  std::mt19937 rng { 42U };
+  std::vector<T> data(count);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<T>(rng() % 100U); });
+  return data;
+}
+
+} /* namespace core */
+
+/*
+ *  MARK: slide
+ *  Every 16-wide window of the span, last element of each summed.
+ */
+template<class T>
+void bench_slide_of() {
+  std::size_t constexpr width { 16U };
+  for (auto const size : core::sizes) {
+    auto const data = core::values<T>(size);
+    auto const span = std::span<T const> { data };
+    auto const windows = size - width + 1U;
+    bench::record("slide", bench::type_name<T>, windows, span.size_bytes(), bench::per_call([&] {
+      T last {};
+      for (std::size_t offset { 0U }; offset != windows; ++offset) {
+        last += cspan::slide(span, offset, width).back();
+      }
+      bench::keep(last);
+    }));
+  }
+}
+
+void bench_slide() {
+  bench::table_header("slide"s, "16-wide windows, at every offset"s);
+  bench_slide_of<std::uint8_t>();
+  bench_slide_of<std::int32_t>();
+  bench_slide_of<std::int64_t>();
+  bench_slide_of<double>();
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: starts_with, ends_with
+ *  Prefix / suffix as long as the data, so every element is compared;
+ *  GB/s counts both spans.
+ */
+template<class T>
+void bench_starts_ends_of(bool const ends) {
+  for (auto const size : core::sizes) {
+    auto const data = core::values<T>(size);
+    auto const copy = data;
+    auto const span = std::span<T const> { data };
+    auto const affix = std::span<T const> { copy };
+    bench::record(ends ? "ends_with" : "starts_with", bench::type_name<T>, size, 2U * span.size_bytes(),
+                  bench::per_call([&] {
+      bench::keep(ends ? cspan::ends_with(span, affix) : cspan::starts_with(span, affix));
+    }));
+  }
+}
+
+void bench_starts_with() {
+  bench::table_header("starts_with"s, "prefix == data"s);
+  bench_starts_ends_of<std::uint8_t>(false);
+  bench_starts_ends_of<std::int32_t>(false);
+  bench_starts_ends_of<std::int64_t>(false);
+  bench_starts_ends_of<double>(false);
+  std::cout << '\n';
+}
+
+void bench_ends_with() {
+  bench::table_header("ends_with"s, "suffix == data"s);
+  bench_starts_ends_of<std::uint8_t>(true);
+  bench_starts_ends_of<std::int32_t>(true);
+  bench_starts_ends_of<std::int64_t>(true);
+  bench_starts_ends_of<double>(true);
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: contains
+ *  An 8-element needle that never occurs: a full scan.
+ */
+template<class T>
+void bench_contains_of() {
+  T needle[8U];
+  std::iota(std::begin(needle), std::end(needle), T { 100 });
+  for (auto const size : core::sizes) {
+    auto const data = core::values<T>(size);
+    auto const span = std::span<T const> { data };
+    bench::record("contains", bench::type_name<T>, size, span.size_bytes(), bench::per_call([&] {
+      bench::keep(cspan::contains(span, std::span<T const> { needle }));
+    }));
+  }
+}
+
+void bench_contains() {
+  bench::table_header("contains"s, "8-element needle, no match"s);
+  bench_contains_of<std::uint8_t>();
+  bench_contains_of<std::int32_t>();
+  bench_contains_of<std::int64_t>();
+  bench_contains_of<double>();
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: display
+ *  The "std::span, subspan" display loop of spans.cpp: a 20-column grid,
+ *  one row per offset, putc() to /dev/null; elements are characters
+ *  written.
+ */
+void bench_display() {
+  bench::table_header("display"s, "20-column subspan grid, putc to /dev/null"s);
+  std::FILE * const sink = std::fopen("/dev/null", "w");
+  if (sink == nullptr) {
+    std::cout << "  /dev/null: "s << std::strerror(errno) << "\n\n"s;
+    return;
+  }
+
+  std::size_t constexpr columns { 20U };
+  for (auto const size : core::print_sizes) {
+    std::vector<char> abc(size);
+    for (std::size_t ix { 0U }; ix != size; ++ix) {
+      abc[ix] = static_cast<char>('A' + ix % 26U);
+    }
+    auto const span = std::span<char const> { abc };
+    auto const rows = size - columns + 1U;
+    bench::record("display", bench::type_name<char>, rows * columns, rows * (columns + 1U), bench::per_call([&] {
+      for (std::size_t offset { 0U }; offset < rows; ++offset) {
+        auto const row = span.subspan(offset, columns);
+        std::for_each(row.begin(), row.end(), [sink](char const chr) { std::putc(chr, sink); });
+        std::putc('\n', sink);
+      }
+    }));
+  }
+  std::fclose(sink);
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: as_bytes
+ *  The std::as_bytes printer of spans.cpp: every byte of the span as two
+ *  hex digits through cspan::format_to, to /dev/null.
+ */
+template<class T>
+void bench_as_bytes_of(std::ostream & sink) {
+  for (auto const size : core::print_sizes) {
+    auto const data = core::values<T>(size);
+    auto const bytes = std::as_bytes(std::span { data });
+    bench::record("as_bytes", bench::type_name<T>, size, bytes.size(), bench::per_call([&] {
+      cspan::format_buffer out { cspan::thread_format_storage(), sink };
+      cspan::format_to(out, bytes, {
+        .base = cspan::base::hex, .uppercase = true, .width = 2U, .fill = '0',
+        .open = " = { ", .close = " }\n",
+      });
+    }));
+  }
+}
+
+void bench_as_bytes() {
+  bench::table_header("as_bytes"s, "hex dump to /dev/null"s);
+  std::ofstream sink { "/dev/null" };
+  bench_as_bytes_of<std::uint8_t>(sink);
+  bench_as_bytes_of<std::int32_t>(sink);
+  bench_as_bytes_of<std::int64_t>(sink);
+  bench_as_bytes_of<double>(sink);
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: multi_search
+ *  One Aho-Corasick pass vs. one cspan::contains call per pattern,
+ *  both answering "which of the patterns occur in the haystack".
+ */
+void bench_multi_search() {
+  std::cout << "multi_search: 4 MiB haystack, 8-byte patterns\n"s
+            << "  patterns   multi_searcher ms   contains x N ms   speed-up\n"s;
+
+  auto const hay = bench::random_bytes(4U << 20U);
+  auto const span = std::span<unsigned char const> { hay };
+
+  for (std::size_t const count : { 10U, 100U, 1'000U, }) {
+    //  Half the patterns are taken from the haystack, half are random.
+    auto const noise = bench::random_bytes(count * 8U, 7U);
+    std::vector<std::span<unsigned char const>> patterns;
+    std::mt19937 rng { 11U };
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      patterns.push_back(ix % 2U == 0U
+        ? span.subspan(rng() % (hay.size() - 8U), 8U)
+        : std::span<unsigned char const> { noise }.subspan(ix * 8U, 8U));
+    }
+
+    cspan::multi_searcher<unsigned char> const automaton {
+      std::span<std::span<unsigned char const> const> { patterns } };
+    std::vector<bool> seen(count);
+
+    auto const t_multi = bench::best_ns([&] {
+      std::fill(seen.begin(), seen.end(), false);
+      automaton.for_each_match(span, [&seen](auto const & found) {
+        seen[found.pattern] = true;
+        return true;
+      });
+      bench::keep(seen);
+    }, 3);
+
+    auto const t_contains = bench::best_ns([&] {
+      for (std::size_t ix { 0U }; ix != count; ++ix) {
+        seen[ix] = cspan::contains(span, patterns[ix]);
+      }
+      bench::keep(seen);
+    }, 3);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(10) << count
+              << std::setw(19) << t_multi / 1e6
+              << std::setw(18) << t_contains / 1e6
+              << std::setw(11) << t_contains / t_multi << '\n';
+  }
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: rolling
+ *  O(N) rolling aggregates vs. recomputing every window.
+ */
+void bench_rolling() {
+  std::cout << "rolling: 1 Mi floats, ns per output element\n"s
+            << "  width   sum naive   rolling_sum   min naive   rolling_min\n"s;
+
+  auto const bytes = bench::random_bytes(1U << 20U);
+  std::vector<float> const in(bytes.begin(), bytes.end());
+  std::vector<float> out(in.size());
+
+  for (std::size_t const width : { 8U, 64U, 1'024U, }) {
+    auto const count = static_cast<double>(in.size() - width + 1U);
+
+    auto const t_sum_naive = bench::best_ns([&] {
+      for (std::size_t ix { 0U }; ix + width <= in.size(); ++ix) {
+        out[ix] = std::accumulate(in.begin() + ix, in.begin() + ix + width, 0.0F);
+      }
+      bench::keep(out);
+    }, 3);
+    auto const t_sum = bench::best_ns([&] {
+      bench::keep(cspan::rolling_sum(std::span { in }, width, std::span { out }));
+    });
+    auto const t_min_naive = bench::best_ns([&] {
+      for (std::size_t ix { 0U }; ix + width <= in.size(); ++ix) {
+        out[ix] = *std::min_element(in.begin() + ix, in.begin() + ix + width);
+      }
+      bench::keep(out);
+    }, 3);
+    auto const t_min = bench::best_ns([&] {
+      bench::keep(cspan::rolling_min(std::span { in }, width, std::span { out }));
+    });
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(7) << width
+              << std::setw(12) << t_sum_naive / count
+              << std::setw(14) << t_sum / count
+              << std::setw(12) << t_min_naive / count
+              << std::setw(14) << t_min / count << '\n';
+  }
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: reverse_rotate
+ *  In-place reverse / rotate vs. std::reverse / std::rotate, in GB/s of
+ *  span processed, at L1, L2 and DRAM-sized inputs.
+ */
+template<class T>
+void bench_reverse_rotate_of(std::string_view const type) {
+  std::cout << "reverse / rotate: "s << type << ", GB/s\n"s
+            << "      bytes   std::reverse   cspan::reverse"
+               "   std::rotate   cspan::rotate   (shift n/3)\n"s;
+
+  for (std::size_t const bytes : { 16U << 10U, 256U << 10U, 64U << 20U, }) {
+    auto const raw = bench::random_bytes(bytes);
+    std::vector<T> data(bytes / sizeof(T));
+    std::memcpy(data.data(), raw.data(), data.size() * sizeof(T));
+    auto const span = std::span { data };
+    auto const shift = data.size() / 3U;
+    auto const reps = bytes > (1U << 20U) ? 5 : 200;
+    auto const gbps = [bytes](double const ns) {
+      return static_cast<double>(bytes) / ns;
+    };
+
+    auto const t_std_rev = bench::best_ns([&] {
+      std::reverse(data.begin(), data.end());
+      bench::keep(data.front());
+    }, reps);
+    auto const t_rev = bench::best_ns([&] {
+      cspan::reverse(span);
+      bench::keep(data.front());
+    }, reps);
+    auto const t_std_rot = bench::best_ns([&] {
+      std::rotate(data.begin(), data.begin() + shift, data.end());
+      bench::keep(data.front());
+    }, reps);
+    auto const t_rot = bench::best_ns([&] {
+      bench::keep(cspan::rotate(span, shift));
+    }, reps);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(11) << bytes
+              << std::setw(15) << gbps(t_std_rev)
+              << std::setw(17) << gbps(t_rev)
+              << std::setw(14) << gbps(t_std_rot)
+              << std::setw(16) << gbps(t_rot) << '\n';
+  }
+  std::cout << '\n';
+}
+
+void bench_reverse_rotate() {
+  bench_reverse_rotate_of<std::uint8_t>("uint8_t"s);
+  bench_reverse_rotate_of<std::int32_t>("int32_t"s);
+  bench_reverse_rotate_of<double>("double"s);
+}
+
+/*
+ *  MARK: filter
+ *  std::copy_if with a branchy predicate vs. cspan::filter with the same
+ *  lambda (branchless) and with cspan::in_range (compress kernel).
+ *  Random data, about half the elements kept.
+ */
+template<class T>
+void bench_filter_of(std::string_view const type, T const lo, T const hi) {
+  auto const bytes = bench::random_bytes(4U << 20U);
+  std::vector<T> in(bytes.size() / sizeof(T));
+  std::memcpy(in.data(), bytes.data(), in.size() * sizeof(T));
+  std::vector<T> out(in.size());
+  auto const pred = [lo, hi](T const val) { return lo <= val && val <= hi; };
+  auto const count = static_cast<double>(in.size());
+
+  auto const t_copy_if = bench::best_ns([&] {
+    bench::keep(std::copy_if(in.begin(), in.end(), out.begin(), pred));
+  });
+  auto const t_lambda = bench::best_ns([&] {
+    bench::keep(cspan::filter(std::span { in }, std::span { out }, pred));
+  });
+  auto const t_range = bench::best_ns([&] {
+    bench::keep(cspan::filter(std::span { in }, std::span { out }, cspan::in_range { lo, hi }));
+  });
+
+  std::cout << std::fixed << std::setprecision(3)
+            << std::setw(9) << type
+            << std::setw(14) << t_copy_if / count
+            << std::setw(17) << t_lambda / count
+            << std::setw(19) << t_range / count << '\n';
+}
+
+void bench_filter() {
+  std::cout << "filter: 4 MiB, ns per input element\n"s
+            << "     type   std::copy_if   filter(lambda)   filter(in_range)\n"s;
+  bench_filter_of<std::uint8_t>("uint8_t"s, 64U, 191U);
+  bench_filter_of<std::int32_t>("int32_t"s, -(1 << 30), 1 << 30);
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: format
+ *  Dumping a span to a stream: element-by-element iostream formatting vs.
+ *  cspan::format_to into a 64 KiB buffer. The sink is /dev/null, so the
+ *  time is formatting plus the write calls.
+ */
+void bench_format() {
+  std::cout << "format: 1 Mi uint32_t to /dev/null, MB/s of text\n"s
+            << "          mode   iostream   format_to   speed-up\n"s;
+
+  auto const bytes = bench::random_bytes(4U << 20U);
+  std::vector<std::uint32_t> data(bytes.size() / sizeof(std::uint32_t));
+  std::memcpy(data.data(), bytes.data(), bytes.size());
+  std::ofstream sink { "/dev/null" };
+  std::vector<char> storage(64U << 10U);
+
+  auto const run = [&](std::string_view const mode, auto && stream_fn,
+                       cspan::format_options const & options) {
+    std::ostringstream probe;
+    {
+      cspan::format_buffer out { std::span { storage }, probe };
+      cspan::format_to(out, std::span { data }, options);
+    }
+    auto const text = static_cast<double>(probe.str().size());
+
+    auto const t_stream = bench::best_ns([&] { stream_fn(); sink.flush(); }, 3);
+    auto const t_format = bench::best_ns([&] {
+      cspan::format_buffer out { std::span { storage }, sink };
+      cspan::format_to(out, std::span { data }, options);
+    }, 3);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(14) << mode
+              << std::setw(11) << text * 1e3 / t_stream
+              << std::setw(12) << text * 1e3 / t_format
+              << std::setw(11) << t_stream / t_format << '\n';
+  };
+
+  run("decimal"s, [&] {
+    for (auto const elem : data) {
+      sink << elem << ' ';
+    }
+  }, {});
+  run("hex, width 8"s, [&] {
+    sink << std::hex << std::setfill('0');
+    for (auto const elem : data) {
+      sink << std::setw(8) << elem << ' ';
+    }
+    sink << std::dec << std::setfill(' ');
+  }, { .base = cspan::base::hex, .width = 8U, .fill = '0', });
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: stream
+ *  cspan::stream_reader over a 256 MiB file, each chunk searched and
+ *  summed: reading on the caller's thread vs. prefetching the next chunk
+ *  on the worker. The file's pages are dropped from the page cache before
+ *  every run (where posix_fadvise exists), so the reads go to the device.
+ */
+void bench_stream() {
+  std::cout << "stream: 256 MiB file, cold cache, search + sum per chunk, GB/s\n"s
+            << "     chunk   synchronous   prefetch\n"s;
+
+  auto const path = std::filesystem::temp_directory_path() / "cspan_bench_stream.bin";
+  {
+    std::ofstream file { path, std::ios::binary };
+    auto const block = bench::random_bytes(1U << 20U);
+    for (int ix { 0 }; ix != 256; ++ix) {
+      file.write(reinterpret_cast<char const *>(block.data()), static_cast<std::streamsize>(block.size()));
+    }
+  }
+  std::uint8_t constexpr word[] { 'c', 's', 'p', 'a', 'n', };
+  auto const search = cspan::searcher<std::byte> { std::as_bytes(std::span { word }) };
+
+  auto const run = [&](std::size_t const chunk, bool const prefetch) {
+    auto const fd = ::open(path.c_str(), O_RDONLY);
+#if defined(POSIX_FADV_DONTNEED)
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif  /* defined(POSIX_FADV_DONTNEED) */
+    auto const start = bench::clock::now();
+    std::size_t total { 0U };
+    {
+      cspan::stream_reader reader { fd, { .chunk_size = chunk, .overlap = 4U, .prefetch = prefetch, } };
+      for (auto span = reader.next(); !span.empty(); span = reader.next()) {
+        total += search.count(span);
+        total += cspan::sum(std::span { reinterpret_cast<std::uint8_t const *>(span.data()), span.size() },
+                            std::size_t { 0U });
+      }
+    }
+    bench::keep(total);
+    auto const elapsed = std::chrono::duration<double, std::nano> { bench::clock::now() - start };
+    ::close(fd);
+    return elapsed.count();
+  };
+
+  for (std::size_t const chunk : { 256U << 10U, 1U << 20U, 4U << 20U, }) {
+    auto t_sync { 1e300 };
+    auto t_async { 1e300 };
+    for (int rep { 0 }; rep != 3; ++rep) {
+      t_sync = std::min(t_sync, run(chunk, false));
+      t_async = std::min(t_async, run(chunk, true));
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(9) << (chunk >> 10U) << 'K'
+              << std::setw(14) << (256U << 20U) / t_sync
+              << std::setw(11) << (256U << 20U) / t_async << '\n';
+  }
+  std::filesystem::remove(path);
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: parallel
+ *  cspan::par::* on a 1 GiB byte span, pools of 1 .. hardware_concurrency
+ *  participants; GB/s of input.
+ */
+void bench_parallel() {
+  auto const cores = std::max(1U, std::thread::hardware_concurrency());
+  std::cout << "parallel: 1 GiB uint8_t, "s << cores << " hardware threads, GB/s\n"s
+            << "  threads     count   contains    reduce   transform\n"s;
+
+  std::vector<std::uint8_t> data(1U << 30U);
+  {
+    auto const block = bench::random_bytes(1U << 20U);
+    for (std::size_t ix { 0U }; ix < data.size(); ix += block.size()) {
+      std::memcpy(data.data() + ix, block.data(), block.size());
+    }
+  }
+  std::vector<std::uint8_t> out(data.size());
+  std::uint8_t constexpr missing[] { 'c', 's', 'p', 'a', 'n', 0U, 0U, 0U, };
+  auto const span = std::span<std::uint8_t const> { data };
+  auto const gbps = [&data](double const ns) { return static_cast<double>(data.size()) / ns; };
+
+  for (std::size_t threads { 1U }; threads <= cores; threads = threads < cores ? std::min<std::size_t>(threads * 2U, cores) : threads + 1U) {
+    cspan::par::thread_pool pool { threads };
+    auto const t_count = bench::best_ns([&] {
+      bench::keep(cspan::par::count(pool, span, std::span { missing }));
+    }, 3);
+    auto const t_contains = bench::best_ns([&] {
+      bench::keep(cspan::par::contains(pool, span, std::span { missing }));
+    }, 3);
+    auto const t_reduce = bench::best_ns([&] {
+      bench::keep(cspan::par::reduce(pool, span, std::uint64_t { 0U }, std::plus<> {}));
+    }, 3);
+    auto const t_transform = bench::best_ns([&] {
+      cspan::par::transform(pool, span, std::span { out }, [](std::uint8_t const val) {
+        return static_cast<std::uint8_t>(val * 3U + 1U);
+      });
+      bench::keep(out.back());
+    }, 3);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(9) << threads
+              << std::setw(10) << gbps(t_count)
+              << std::setw(11) << gbps(t_contains)
+              << std::setw(10) << gbps(t_reduce)
+              << std::setw(12) << gbps(t_transform) << '\n';
+  }
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: arena
+ *  Per-message scratch buffers: a std::vector per buffer vs. spans from
+ *  cspan::thread_arena() rewound by an arena_scope after each message.
+ *  Each message takes 8 buffers of 16 .. 4096 int, fills and sums them.
+ */
+void bench_arena() {
+  std::cout << "arena: 100 Ki messages of 8 scratch buffers, ns/message\n"s
+            << "     vector      arena   speed-up\n"s;
+
+  std::size_t constexpr messages { 100U << 10U };
+  std::size_t constexpr buffers { 8U };
+  std::vector<std::size_t> sizes(messages * buffers);
+  {
+    std::mt19937 rng { 42U };
+    std::generate(sizes.begin(), sizes.end(), [&rng] { return std::size_t { 16U } << (rng() % 9U); });
+  }
+
+  auto const work = [](std::span<int> const buf) {
+    std::iota(buf.begin(), buf.end(), 0);
+    return cspan::sum(std::span<int const> { buf }, 0L);
+  };
+
+  auto const t_vector = bench::best_ns([&] {
+    long total { 0L };
+    for (std::size_t msg { 0U }; msg != messages; ++msg) {
+      for (std::size_t ix { 0U }; ix != buffers; ++ix) {
+        std::vector<int> buf(sizes[msg * buffers + ix]);
+        total += work(buf);
+      }
+    }
+    bench::keep(total);
+  }, 3);
+  auto const t_arena = bench::best_ns([&] {
+    long total { 0L };
+    auto & scratch = cspan::thread_arena();
+    for (std::size_t msg { 0U }; msg != messages; ++msg) {
+      cspan::arena_scope const scope { scratch };
+      for (std::size_t ix { 0U }; ix != buffers; ++ix) {
+        total += work(scratch.allocate_span<int>(sizes[msg * buffers + ix]));
+      }
+    }
+    bench::keep(total);
+  }, 3);
+
+  std::cout << std::fixed << std::setprecision(1)
+            << std::setw(11) << t_vector / messages
+            << std::setw(11) << t_arena / messages
+            << std::setw(11) << t_vector / t_arena << '\n';
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: packed
+ *  Decoding 4 Mi packed 9-byte wire records { uint8_t tag; uint32_t id
+ *  (big-endian); uint32_t value (little-endian); }: memcpy of each record
+ *  into a struct vs. three packed_view fields; M records/s. Both compile
+ *  to plain loads plus bswap; build with -DNDEBUG, or the bounds assert
+ *  in packed_view::operator[] dominates.
+ */
+void bench_packed() {
+  std::cout << "packed: 4 Mi 9-byte records, M records/s\n"s
+            << "     memcpy   packed_view   speed-up\n"s;
+
+  std::size_t constexpr stride { 9U };
+  auto const raw = bench::random_bytes((4U << 20U) * stride);
+  auto const bytes = std::as_bytes(std::span { raw });
+  auto const count = bytes.size() / stride;
+
+  struct record {
+    std::uint8_t tag;
+    std::uint32_t id;
+    std::uint32_t value;
+  };
+  auto const t_memcpy = bench::best_ns([&] {
+    std::uint64_t total { 0U };
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      record rec;
+      auto const at = bytes.data() + ix * stride;
+      std::memcpy(&rec.tag, at, 1U);
+      std::memcpy(&rec.id, at + 1U, 4U);
+      std::memcpy(&rec.value, at + 5U, 4U);
+      if constexpr (std::endian::native == std::endian::little) {
+        rec.id = cspan::detail::byteswap(rec.id);
+      }
+      total += rec.tag == 0U ? 0U : rec.id ^ rec.value;
+    }
+    bench::keep(total);
+  });
+  auto const t_view = bench::best_ns([&] {
+    cspan::packed_view<std::uint8_t> const tags { bytes, stride };
+    cspan::packed_view<std::uint32_t, std::endian::big> const ids { bytes.subspan(1U), stride };
+    cspan::packed_view<std::uint32_t, std::endian::little> const values { bytes.subspan(5U), stride };
+    std::uint64_t total { 0U };
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      total += tags[ix] == 0U ? 0U : ids[ix] ^ values[ix];
+    }
+    bench::keep(total);
+  });
+
+  auto const mrps = [count](double const ns) { return static_cast<double>(count) * 1e3 / ns; };
+  std::cout << std::fixed << std::setprecision(1)
+            << std::setw(11) << mrps(t_memcpy)
+            << std::setw(14) << mrps(t_view)
+            << std::setw(11) << t_memcpy / t_view << '\n';
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: transpose
+ *  Transposing a 4096 x 4096 float matrix (64 MiB each way): the naive
+ *  row-by-row loop vs. the cache-blocked cspan::transpose; GB/s read.
+ */
+void bench_transpose() {
+  std::cout << "transpose: 4096 x 4096 float, GB/s\n"s
+            << "      naive    blocked   speed-up\n"s;
+
+  std::size_t constexpr edge { 4096U };
+  std::vector<float> src(edge * edge);
+  std::vector<float> dst(edge * edge);
+  std::iota(src.begin(), src.end(), 0.0f);
+  cspan::span2d<float const> const from { std::span<float const> { src }, edge, edge };
+  cspan::span2d<float> const to { std::span { dst }, edge, edge };
+
+  auto const t_naive = bench::best_ns([&] {
+    for (std::size_t row { 0U }; row != edge; ++row) {
+      for (std::size_t col { 0U }; col != edge; ++col) {
+        dst[col * edge + row] = src[row * edge + col];
+      }
+    }
+    bench::keep(dst[1U]);
+  }, 3);
+  auto const t_blocked = bench::best_ns([&] {
+    cspan::transpose(from, to);
+    bench::keep(dst[1U]);
+  }, 3);
+
+  auto const gbps = [&src](double const ns) { return static_cast<double>(src.size() * sizeof(float)) / ns; };
+  std::cout << std::fixed << std::setprecision(2)
+            << std::setw(11) << gbps(t_naive)
+            << std::setw(11) << gbps(t_blocked)
+            << std::setw(11) << t_naive / t_blocked << '\n';
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: soa
+ *  8 Mi 32-byte particles { x, y, z, vx, vy, vz, mass; id; }: scans of
+ *  one field (sum of id) and two fields (x += vx * dt) over an AoS
+ *  std::vector<struct> vs. a cspan::soa's columns; M particles/s.
+ */
+void bench_soa() {
+  std::cout << "soa: 8 Mi 32-byte particles, M particles/s\n"s
+            << "                   scan        aos        soa   speed-up\n"s;
+
+  struct particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    std::int32_t id;
+  };
+  std::size_t constexpr count { 8U << 20U };
+  std::vector<particle> aos(count);
+  {
+    std::mt19937 rng { 42U };
+    std::uniform_real_distribution<float> dist { 0.0f, 1.0f };
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      aos[ix] = { dist(rng), dist(rng), dist(rng), dist(rng), dist(rng), dist(rng), dist(rng),
+                  static_cast<std::int32_t>(ix), };
+    }
+  }
+  using particles = cspan::soa<float, float, float, float, float, float, float, std::int32_t>;
+  particles columns;
+  auto const t_convert = bench::best_ns([&] {
+    cspan::aos_to_soa(std::span<particle const> { aos }, columns,
+                      &particle::x, &particle::y, &particle::z,
+                      &particle::vx, &particle::vy, &particle::vz, &particle::mass, &particle::id);
+  }, 3);
+  auto const mps = [](double const ns) { return static_cast<double>(count) * 1e3 / ns; };
+
+  auto const report = [&mps](std::string_view const scan, double const t_aos, double const t_soa) {
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(23) << scan
+              << std::setw(11) << mps(t_aos)
+              << std::setw(11) << mps(t_soa)
+              << std::setw(11) << t_aos / t_soa << '\n';
+  };
+
+  report("sum(id)"s, bench::best_ns([&] {
+    std::int64_t total { 0 };
+    for (auto const & part : aos) {
+      total += part.id;
+    }
+    bench::keep(total);
+  }), bench::best_ns([&] {
+    std::int64_t total { 0 };
+    for (auto const id : columns.column<7>()) {
+      total += id;
+    }
+    bench::keep(total);
+  }));
+
+  float constexpr dt { 0.01f };
+  report("x += vx * dt"s, bench::best_ns([&] {
+    for (auto & part : aos) {
+      part.x += part.vx * dt;
+    }
+    bench::keep(aos.back().x);
+  }), bench::best_ns([&] {
+    auto const xs = columns.column<0>();
+    auto const vxs = columns.column<3>();
+    for (std::size_t ix { 0U }; ix != xs.size(); ++ix) {
+      xs[ix] += vxs[ix] * dt;
+    }
+    bench::keep(xs.back());
+  }));
+  std::cout << "  aos_to_soa: "s << std::setprecision(1) << mps(t_convert) << " M particles/s\n"s;
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: hash
+ *  64 MiB of random bytes: cspan::hash vs. std::hash<std::string_view>,
+ *  cspan::crc32c hardware vs. table, and content_chunks(); GB/s.
+ */
+void bench_hash() {
+  std::cout << "hash: 64 MiB random bytes, GB/s\n"s;
+
+  auto const data = bench::random_bytes(64U << 20U);
+  auto const bytes = std::as_bytes(std::span { data });
+  std::string_view const text { reinterpret_cast<char const *>(data.data()), data.size() };
+  auto const gbps = [&data](double const ns) { return static_cast<double>(data.size()) / ns; };
+
+  auto const report = [&gbps](std::string_view const name, double const ns) {
+    std::cout << std::setw(26) << name << std::fixed << std::setprecision(2)
+              << std::setw(9) << gbps(ns) << '\n';
+  };
+  report("std::hash<string_view>"s, bench::best_ns([&] {
+    bench::keep(std::hash<std::string_view> {}(text));
+  }));
+  report("cspan::hash"s, bench::best_ns([&] {
+    bench::keep(cspan::hash(bytes));
+  }));
+  report("hasher, 4 KiB updates"s, bench::best_ns([&] {
+    cspan::hasher digest;
+    digest.update_each(cspan::chunks(bytes, 4U << 10U));
+    bench::keep(digest.digest());
+  }));
+  report("crc32c, tables"s, bench::best_ns([&] {
+    bench::keep(~cspan::detail::crc32c_scalar(~0U, bytes.data(), bytes.size()));
+  }));
+  report("crc32c"s, bench::best_ns([&] {
+    bench::keep(cspan::crc32c(bytes));
+  }));
+  report("content_chunks"s, bench::best_ns([&] {
+    std::size_t chunks { 0U };
+    for (auto const chunk : cspan::content_chunks(bytes)) {
+      chunks += chunk.empty() ? 0U : 1U;
+    }
+    bench::keep(chunks);
+  }, 3));
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: pipeline
+ *  16 Mi int through map (x * 3 + 1) -> filter (x % 4 != 0) -> 8-wide
+ *  window sums -> sum: one std:: algorithm pass per step into full-size
+ *  vectors vs. the fused cspan::pipeline; M elements/s of input.
+ */
+void bench_pipeline() {
+  std::cout << "pipeline: 16 Mi int, M elements/s\n"s
+            << "                           chain     staged      fused   speed-up\n"s;
+
+  std::size_t constexpr count { 16U << 20U };
+  std::size_t constexpr width { 8U };
+  std::vector<int> data(count);
+  {
+    std::mt19937 rng { 42U };
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<int>(rng() % 1'000U); });
+  }
+  auto const source = std::span<int const> { data };
+  auto const map = [](int const val) { return val * 3 + 1; };
+  auto const keep = [](int const val) { return val % 4 != 0; };
+  auto const window_sum = [](std::span<int const> const win) { return cspan::sum(win); };
+  std::vector<int> mapped(count);
+  std::vector<int> kept(count);
+  std::vector<int> sums(count);
+  auto const meps = [](double const ns) { return static_cast<double>(count) * 1e3 / ns; };
+
+  auto const report = [&meps](std::string_view const chain, double const t_staged, double const t_fused) {
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(32) << chain
+              << std::setw(11) << meps(t_staged)
+              << std::setw(11) << meps(t_fused)
+              << std::setw(11) << t_staged / t_fused << '\n';
+  };
+
+  report("map -> filter -> sum"s, bench::best_ns([&] {
+    std::transform(data.begin(), data.end(), mapped.begin(), map);
+    auto const end = std::copy_if(mapped.begin(), mapped.end(), kept.begin(), keep);
+    bench::keep(std::accumulate(kept.begin(), end, 0L));
+  }), bench::best_ns([&] {
+    bench::keep(cspan::pipeline { source }.map(map).filter(keep).sum(0L));
+  }));
+  report("map -> filter -> window -> sum"s, bench::best_ns([&] {
+    std::transform(data.begin(), data.end(), mapped.begin(), map);
+    auto const end = std::copy_if(mapped.begin(), mapped.end(), kept.begin(), keep);
+    auto const size = static_cast<std::size_t>(end - kept.begin());
+    auto const windows = size < width ? 0U : size - width + 1U;
+    for (std::size_t ix { 0U }; ix != windows; ++ix) {
+      sums[ix] = window_sum(std::span<int const> { kept.data() + ix, width });
+    }
+    bench::keep(std::accumulate(sums.begin(), sums.begin() + static_cast<std::ptrdiff_t>(windows), 0L));
+  }), bench::best_ns([&] {
+    bench::keep(cspan::pipeline { source }.map(map).filter(keep).windows(width, window_sum).sum(0L));
+  }));
+  std::cout << '\n';
+}
+
+#if (CSPAN_HAS_MMAP)
+/*
+ *  MARK: ring
+ *  16 Mi int handed from a producer thread to a consumer thread in
+ *  batches: a std::vector per batch through a mutex-guarded std::deque
+ *  (both bounded to 64 Ki elements in flight) vs. cspan::ring written
+ *  and read in place; M elements/s.
+ */
+void bench_ring() {
+  std::cout << "ring: 16 Mi int, producer -> consumer, M elements/s\n"s
+            << "   batch   vector+mutex   ring spsc   ring mpmc\n"s;
+
+  std::size_t constexpr count { 16U << 20U };
+  std::size_t constexpr in_flight { 64U << 10U };
+  auto const meps = [](double const ns) { return static_cast<double>(count) * 1e3 / ns; };
+
+  //  Producer writes ix, consumer sums; the sum is checked by keep().
+  auto const vectors = [](std::size_t const batch) {
+    std::mutex lock;
+    std::deque<std::vector<int>> queue;
+    std::thread producer { [&] {
+      for (std::size_t done { 0U }; done != count; done += batch) {
+        std::vector<int> out(batch);
+        std::iota(out.begin(), out.end(), static_cast<int>(done));
+        for (;;) {
+          {
+            std::lock_guard const hold { lock };
+            if (queue.size() * batch < in_flight) {
+              queue.push_back(std::move(out));
+              break;
+            }
+          }
+          std::this_thread::yield();
+        }
+      }
+    } };
+    long total { 0L };
+    for (std::size_t seen { 0U }; seen != count;) {
+      std::vector<int> in;
+      {
+        std::lock_guard const hold { lock };
+        if (!queue.empty()) {
+          in = std::move(queue.front());
+          queue.pop_front();
+        }
+      }
+      if (in.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+      total = std::accumulate(in.begin(), in.end(), total);
+      seen += in.size();
+    }
+    producer.join();
+    bench::keep(total);
+  };
+
+  auto const ring = [in_flight]<cspan::ring_mode Mode>(std::size_t const batch, std::integral_constant<cspan::ring_mode, Mode>) {
+    cspan::ring<int, Mode> queue { in_flight };
+    std::thread producer { [&] {
+      for (std::size_t done { 0U }; done != count; done += batch) {
+        auto out = queue.reserve(batch);
+        for (; out.empty(); out = queue.reserve(batch)) {
+          std::this_thread::yield();
+        }
+        std::iota(out.begin(), out.end(), static_cast<int>(done));
+        queue.commit(out);
+      }
+    } };
+    long total { 0L };
+    for (std::size_t seen { 0U }; seen != count;) {
+      auto const in = queue.peek();
+      if (in.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+      total = std::accumulate(in.begin(), in.end(), total);
+      seen += in.size();
+      queue.release(in);
+    }
+    producer.join();
+    bench::keep(total);
+  };
+
+  for (std::size_t const batch : { 16U, 256U, 4'096U, }) {
+    auto const t_vectors = bench::best_ns([&] { vectors(batch); }, 3);
+    auto const t_spsc = bench::best_ns([&] {
+      ring(batch, std::integral_constant<cspan::ring_mode, cspan::ring_mode::spsc> {});
+    }, 3);
+    auto const t_mpmc = bench::best_ns([&] {
+      ring(batch, std::integral_constant<cspan::ring_mode, cspan::ring_mode::mpmc> {});
+    }, 3);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(8) << batch
+              << std::setw(15) << meps(t_vectors)
+              << std::setw(12) << meps(t_spsc)
+              << std::setw(12) << meps(t_mpmc) << '\n';
+  }
+  std::cout << '\n';
+}
+#endif  /* (CSPAN_HAS_MMAP) */
+
+/*
+ *  MARK: inline_buffer
+ *  1 Mi short int sequences built element by element and summed, sizes
+ *  drawn as 60% 1-4, 25% 5-16, 12% 17-64, 3% 65-512: heap allocations
+ *  per 1000 sequences and ns per sequence.
+ */
+void bench_inline_buffer() {
+  std::cout << "inline_buffer: 1 Mi sequences, sizes 60% 1-4, 25% 5-16, 12% 17-64, 3% 65-512\n"s
+            << "                               container   allocs/1000   ns/sequence\n"s;
+
+  std::vector<std::uint16_t> sizes(1U << 20U);
+  {
+    std::mt19937 rng { 42U };
+    std::generate(sizes.begin(), sizes.end(), [&rng]() -> std::uint16_t {
+      auto const pick = rng() % 100U;
+      auto const [lo, hi] = pick < 60U ? std::pair { 1U, 4U }
+                          : pick < 85U ? std::pair { 5U, 16U }
+                          : pick < 97U ? std::pair { 17U, 64U }
+                          : std::pair { 65U, 512U };
+      return static_cast<std::uint16_t>(lo + rng() % (hi - lo + 1U));
+    });
+  }
+
+  //  done() runs after each sequence is destroyed.
+  auto const run = [&sizes](std::string_view const name, auto && make, auto && done) {
+    auto const build = [&sizes, &make, &done] {
+      long total { 0L };
+      for (auto const size : sizes) {
+        {
+          auto seq = make();
+          for (int ix { 0 }; ix != static_cast<int>(size); ++ix) {
+            seq.push_back(ix);
+          }
+          total += std::accumulate(seq.begin(), seq.end(), 0L);
+        }
+        done();
+      }
+      bench::keep(total);
+    };
+    auto const before = bench::allocations.load(std::memory_order_relaxed);
+    build();
+    auto const allocs = bench::allocations.load(std::memory_order_relaxed) - before;
+    auto const t_build = bench::best_ns(build, 3);
+
+    auto const count = static_cast<double>(sizes.size());
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(40) << name
+              << std::setw(14) << static_cast<double>(allocs) * 1e3 / count
+              << std::setw(14) << t_build / count << '\n';
+  };
+
+  auto const nothing = [] {};
+  run("std::vector<int>"s, [] { return std::vector<int> {}; }, nothing);
+  run("std::vector<int>, reserve(16)"s, [] {
+    std::vector<int> seq;
+    seq.reserve(16U);
+    return seq;
+  }, nothing);
+  run("cspan::inline_buffer<int, 16>"s, [] { return cspan::inline_buffer<int, 16> {}; }, nothing);
+  //  Spills go to one arena, reset after every sequence: its blocks are
+  //  allocated once and reused.
+  cspan::arena spill;
+  run("cspan::inline_buffer<int, 16>, arena"s, [&spill] {
+    return cspan::inline_buffer<int, 16> { spill };
+  }, [&spill] { spill.reset(); });
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: static tables
+ *  Keyword lookup, 1 Mi probes (half hits, half misses) against the 64
+ *  C++ keywords below: linear scan, std::lower_bound and
+ *  std::unordered_set vs. the compile-time cspan::static_set and
+ *  cspan::perfect_hash; ns/lookup.
+ */
+namespace tables {
+
+std::string_view constexpr keywords[] {
+  "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch",
+  "char", "char16_t", "char32_t", "char8_t", "class", "concept", "const", "consteval",
+  "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype",
+  "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit",
+  "export", "extern", "false", "float", "for", "friend", "goto", "if",
+  "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "nullptr",
+  "operator", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return",
+  "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+};
+
+auto constexpr sorted_keywords = cspan::sorted(std::span { keywords });
+cspan::static_set constexpr keyword_set { std::span { keywords } };
+cspan::perfect_hash constexpr keyword_hash { std::span { keywords } };
+
+} /* namespace tables */
+
+void bench_static() {
+  std::cout << "static tables: 64 keywords, 1 Mi lookups (50% hits)\n"s
+            << "                 lookup   ns/lookup\n"s;
+
+  //  Misses are keywords with their last letter changed: same lengths,
+  //  same prefixes.
+  std::vector<std::string> owned;
+  for (auto const word : tables::keywords) {
+    owned.emplace_back(word).back() ^= 0x20;
+  }
+  std::vector<std::string_view> probes(1U << 20U);
+  {
+    std::mt19937 rng { 42U };
+    std::generate(probes.begin(), probes.end(), [&rng, &owned] {
+      auto const ix = rng() % std::size(tables::keywords);
+      return rng() % 2U == 0U ? tables::keywords[ix] : std::string_view { owned[ix] };
+    });
+  }
+
+  auto const run = [&probes](std::string_view const name, auto && lookup) {
+    auto const t_lookup = bench::best_ns([&] {
+      std::size_t hits { 0U };
+      for (auto const probe : probes) {
+        hits += lookup(probe) ? 1U : 0U;
+      }
+      bench::keep(hits);
+    });
+    std::cout << std::setw(23) << name << std::fixed << std::setprecision(2)
+              << std::setw(12) << t_lookup / static_cast<double>(probes.size()) << '\n';
+  };
+
+  run("linear scan"s, [](std::string_view const probe) {
+    return std::find(std::begin(tables::keywords), std::end(tables::keywords), probe)
+        != std::end(tables::keywords);
+  });
+  run("std::lower_bound"s, [](std::string_view const probe) {
+    auto const at = std::lower_bound(tables::sorted_keywords.begin(), tables::sorted_keywords.end(), probe);
+    return at != tables::sorted_keywords.end() && *at == probe;
+  });
+  std::unordered_set<std::string_view> const set { std::begin(tables::keywords), std::end(tables::keywords) };
+  run("std::unordered_set"s, [&set](std::string_view const probe) {
+    return set.contains(probe);
+  });
+  run("cspan::static_set"s, [](std::string_view const probe) {
+    return tables::keyword_set.contains(probe);
+  });
+  run("cspan::perfect_hash"s, [](std::string_view const probe) {
+    return tables::keyword_hash.contains(probe);
+  });
+  std::cout << '\n';
+}
+
+/*
+ *  MARK: search trees
+ *  lower_bound of 1 Mi random int32 queries in sorted arrays of 1, 16
+ *  and 64 Mi elements: binary search on the sorted span (std:: and the
+ *  branch-free cspan::) vs. the Eytzinger and B+ tree layouts, one query
+ *  at a time and batched; ns/lookup.
+ */
+void bench_search_tree() {
+  std::size_t const sizes[] { 1U << 20U, 1U << 24U, 1U << 26U, };
+  std::cout << "search trees: 1 Mi random lower_bound queries, ns/lookup\n"s
+            << "                     layout"s;
+  for (auto const size : sizes) {
+    std::cout << std::setw(8) << (size >> 20U) << " Mi"s;
+  }
+  std::cout << '\n';
+
+  std::vector<std::int32_t> queries(1U << 20U);
+  std::vector<std::size_t> out(queries.size());
+  std::array<std::array<double, std::size(sizes)>, 6U> ns {};
+  for (std::size_t column { 0U }; column != std::size(sizes); ++column) {
+    //  Even values: half the queries hit, half fall between.
+    std::vector<std::int32_t> sorted(sizes[column]);
+    for (std::size_t ix { 0U }; ix != sorted.size(); ++ix) {
+      sorted[ix] = static_cast<std::int32_t>(2U * ix);
+    }
+    std::mt19937 rng { 42U };
+    std::generate(queries.begin(), queries.end(), [&rng, &sorted] {
+      return static_cast<std::int32_t>(rng() % (2U * sorted.size()));
+    });
+    auto const span = std::span<std::int32_t const> { sorted };
+    cspan::eytzinger_index const eytzinger { span };
+    cspan::static_btree const btree { span };
+
+    auto const each = [&queries](auto && lookup) {
+      return bench::best_ns([&] {
+        std::size_t total { 0U };
+        for (auto const query : queries) {
+          total += lookup(query);
+        }
+        bench::keep(total);
+      }, 3);
+    };
+    auto const batch = [&queries, &out](auto const & tree) {
+      return bench::best_ns([&] {
+        tree.lower_bound(std::span<std::int32_t const> { queries }, std::span { out });
+        bench::keep(out.back());
+      }, 3);
+    };
+    ns[0U][column] = each([&sorted](std::int32_t const query) {
+      return static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), query) - sorted.begin());
+    });
+    ns[1U][column] = each([span](std::int32_t const query) { return cspan::lower_bound(span, query); });
+    ns[2U][column] = each([&eytzinger](std::int32_t const query) { return eytzinger.lower_bound(query); });
+    ns[3U][column] = batch(eytzinger);
+    ns[4U][column] = each([&btree](std::int32_t const query) { return btree.lower_bound(query); });
+    ns[5U][column] = batch(btree);
+  }
+
+  std::string_view const names[] {
+    "std::lower_bound", "cspan::lower_bound", "eytzinger_index",
+    "eytzinger_index, batched", "static_btree", "static_btree, batched",
+  };
+  for (std::size_t row { 0U }; row != std::size(names); ++row) {
+    std::cout << std::setw(27) << names[row] << std::fixed << std::setprecision(1);
+    for (auto const time : ns[row]) {
+      std::cout << std::setw(11) << time / static_cast<double>(queries.size());
+    }
+    std::cout << '\n';
+  }
+  std::cout << '\n';
+}
+
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+/*
+ *  MARK: main()
+ */
+int main(int argc, const char * argv[]) {
+  auto format { bench::output::text };
+  std::string_view filter {};
+  for (int arg { 1 }; arg < argc; ++arg) {
+    std::string_view const option { argv[arg] };
+    if (option == "--json"s) {
+      format = bench::output::json;
+    }
+    else if (option == "--csv"s) {
+      format = bench::output::csv;
+    }
+    else {
+      filter = option;
+    }
+  }
+
+  //  Machine-readable output owns stdout; the tables go to stderr.
+  auto const stdout_buf = std::cout.rdbuf();
+  if (format != bench::output::text) {
+    std::cout.rdbuf(std::cerr.rdbuf());
+  }
+
+  struct entry {
+    std::string_view name;
+    std::function<void()> run;
+  };
+  entry const benchmarks[] {
+    { "slide",          bench_slide,          },
+    { "starts_with",    bench_starts_with,    },
+    { "ends_with",      bench_ends_with,      },
+    { "contains",       bench_contains,       },
+    { "display",        bench_display,        },
+    { "as_bytes",       bench_as_bytes,       },
+    { "multi_search",   bench_multi_search,   },
+    { "rolling",        bench_rolling,        },
+    { "reverse_rotate", bench_reverse_rotate, },
+    { "filter",         bench_filter,         },
+    { "format",         bench_format,         },
+    { "stream",         bench_stream,         },
+    { "parallel",       bench_parallel,       },
+    { "arena",          bench_arena,          },
+    { "packed",         bench_packed,         },
+    { "transpose",      bench_transpose,      },
+    { "soa",            bench_soa,            },
+    { "hash",           bench_hash,           },
+    { "pipeline",       bench_pipeline,       },
+#if (CSPAN_HAS_MMAP)
+    { "ring",           bench_ring,           },
+#endif  /* (CSPAN_HAS_MMAP) */
+    { "inline_buffer",  bench_inline_buffer,  },
+    { "static",         bench_static,         },
+    { "search_tree",    bench_search_tree,    },
+  };
+
+  for (auto const & [name, run] : benchmarks) {
+    if (name.find(filter) != std::string_view::npos) {
+      run();
+    }
+  }
+
+  std::cout.rdbuf(stdout_buf);
+  bench::write_results(std::cout, format);
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+//
+//  cspan_codegen.cpp
+//  CF.STL_Containers_Span
+//
+//  Code-generation probes for the fixed-extent algorithms in
+//  cspan_algorithm.hpp: every static extent N <= 16 should compile to
+//  straight-line code with no loop (no backward branch).
+//
+//  The cspan_codegen ctest (cmake/cspan_codegen_check.cmake) compiles this
+//  file with -O2 -S and fails if a `probe_*` body branches back to one of
+//  its own labels or calls out. To look by hand (from this directory):
+//    c++ -std=c++20 -O2 -I. -S -o - cspan_codegen.cpp | c++filt
+//  The dynamic-extent probes at the end are the loops, for comparison.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "cspan_algorithm.hpp"
+
+using i32x4  = std::span<std::int32_t, 4>;
+using i32x16 = std::span<std::int32_t, 16>;
+using u8x16  = std::span<std::uint8_t, 16>;
+using f32x8  = std::span<float, 8>;
+
+//  MARK: - Static extent
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+extern "C" {
+
+void probe_fill_i32x16(i32x16 span, std::int32_t const value) {
+  cspan::fill(span, value);
+}
+
+void probe_copy_i32x16(std::span<std::int32_t const, 16> src, i32x16 dst) {
+  cspan::copy(src, dst);
+}
+
+bool probe_equal_u8x16(u8x16 lhs, u8x16 rhs) {
+  return cspan::equal(lhs, rhs);
+}
+
+void probe_reverse_i32x4(i32x4 span) {
+  cspan::reverse(span);
+}
+
+void probe_reverse_u8x16(u8x16 span) {
+  cspan::reverse(span);
+}
+
+std::int32_t probe_sum_i32x16(i32x16 span) {
+  return cspan::sum(span);
+}
+
+float probe_sum_f32x8(f32x8 span) {
+  return cspan::sum(span);
+}
+
+std::int32_t probe_min_max_i32x16(i32x16 span) {
+  auto const [lo, hi] = cspan::min_max(span);
+  return hi - lo;
+}
+
+//  MARK: - Dynamic extent
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+std::int32_t probe_sum_dynamic(std::span<std::int32_t const> span) {
+  return cspan::sum(span);
+}
+
+float probe_sum_dynamic_f32(std::span<float const> span) {
+  return cspan::sum(span);
+}
+
+} /* extern "C" */
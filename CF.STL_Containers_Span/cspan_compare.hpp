@@ -0,0 +1,76 @@
+//
+//  cspan_compare.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/container/span/as_bytes
+//
+
+#ifndef cspan_compare_hpp
+#define cspan_compare_hpp
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+#include "cspan_view_as.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  MARK: equal_bytes()
+//  Byte-wise equality for the short compares that dominate prefix/suffix
+//  checks: up to 32 bytes are covered by two overlapping loads of one
+//  width (no loop, one branch on the size class); longer runs go to memcmp.
+[[nodiscard]]
+inline bool equal_bytes(void const * lhs, void const * rhs, std::size_t const size) noexcept {
+  auto const lp = static_cast<unsigned char const *>(lhs);
+  auto const rp = static_cast<unsigned char const *>(rhs);
+  if (size > 32U) {
+    return std::memcmp(lp, rp, size) == 0;
+  }
+  if (size > 16U) {
+#if (CSPAN_HAS_TARGET)
+    auto const lo = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(lp)),
+                                   _mm_loadu_si128(reinterpret_cast<__m128i const *>(rp)));
+    auto const hi = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(lp + size - 16U)),
+                                   _mm_loadu_si128(reinterpret_cast<__m128i const *>(rp + size - 16U)));
+    return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xFFFF;
+#else
+    return std::memcmp(lp, rp, size) == 0;
+#endif  /* (CSPAN_HAS_TARGET) */
+  }
+  auto const lb = static_cast<std::byte const *>(lhs);
+  auto const rb = static_cast<std::byte const *>(rhs);
+  if (size >= 8U) {
+    using U = std::uint64_t;
+    return ((load<U, std::endian::native>(lb) ^ load<U, std::endian::native>(rb))
+            | (load<U, std::endian::native>(lb + size - 8U) ^ load<U, std::endian::native>(rb + size - 8U))) == 0U;
+  }
+  if (size >= 4U) {
+    using U = std::uint32_t;
+    return ((load<U, std::endian::native>(lb) ^ load<U, std::endian::native>(rb))
+            | (load<U, std::endian::native>(lb + size - 4U) ^ load<U, std::endian::native>(rb + size - 4U))) == 0U;
+  }
+  if (size == 0U) {
+    return true;
+  }
+  return ((lp[0] ^ rp[0]) | (lp[size / 2U] ^ rp[size / 2U])
+          | (lp[size - 1U] ^ rp[size - 1U])) == 0U;
+}
+
+//  Element types whose == may be answered by comparing bytes. Class types
+//  are excluded even when trivially copyable: their operator== is theirs.
+template<class T>
+inline constexpr bool is_memcmp_comparable_v
+  = is_bitwise_comparable_v<std::remove_cv_t<T>>;
+
+} /* namespace detail */
+} /* namespace cspan */
+
+#endif /* cspan_compare_hpp */
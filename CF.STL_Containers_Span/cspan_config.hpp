@@ -0,0 +1,87 @@
+//
+//  cspan_config.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://gcc.gnu.org/onlinedocs/gcc/x86-Built-in-Functions.html
+//  @see: https://clang.llvm.org/docs/AttributeReference.html#target
+//
+
+#ifndef cspan_config_hpp
+#define cspan_config_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+//  MARK: - Platform.
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+#if (defined(__x86_64__) || defined(_M_X64))
+#define CSPAN_X86 1
+#include <immintrin.h>
+#else
+#define CSPAN_X86 0
+#endif  /* (defined(__x86_64__) || defined(_M_X64)) */
+
+//  Per-function ISA selection: kernels are compiled for their instruction set
+//  and only called after cspan::cpu() confirms the running CPU supports it.
+#if (CSPAN_X86 && (defined(__GNUC__) || defined(__clang__)))
+#define CSPAN_TARGET(isa) __attribute__((target(isa)))
+#define CSPAN_HAS_TARGET 1
+#else
+#define CSPAN_TARGET(isa)
+#define CSPAN_HAS_TARGET 0
+#endif  /* (CSPAN_X86 && (defined(__GNUC__) || defined(__clang__))) */
+
+#if (defined(__GNUC__) || defined(__clang__))
+#define CSPAN_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define CSPAN_ALWAYS_INLINE inline
+#endif  /* (defined(__GNUC__) || defined(__clang__)) */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: cpu_features
+ *  Instruction set extensions available on the running CPU.
+ *  Detected once, on first use.
+ */
+struct cpu_features {
+  bool sse2 { false };
+  bool sse42 { false };
+  bool avx2 { false };
+  bool avx512f { false };
+};
+
+[[nodiscard]]
+inline auto cpu() -> cpu_features const & {
+  static cpu_features const features = [] {
+    cpu_features ftr;
+#if (CSPAN_HAS_TARGET)
+    __builtin_cpu_init();
+    ftr.sse2    = __builtin_cpu_supports("sse2");
+    ftr.sse42   = __builtin_cpu_supports("sse4.2");
+    ftr.avx2    = __builtin_cpu_supports("avx2");
+    ftr.avx512f = __builtin_cpu_supports("avx512f");
+#endif  /* (CSPAN_HAS_TARGET) */
+    return ftr;
+  }();
+  return features;
+}
+
+namespace detail {
+
+//  Element types whose operator== is exactly a comparison of their object
+//  representation; only these may be searched with byte-wise SIMD kernels.
+template<class T>
+inline constexpr bool is_bitwise_comparable_v
+  = (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+  && std::has_unique_object_representations_v<T>;
+
+} /* namespace detail */
+
+} /* namespace cspan */
+
+#endif /* cspan_config_hpp */
@@ -0,0 +1,256 @@
+//
+//  cspan_filter.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/algorithm/copy
+//  @see: https://www.felixcloutier.com/x86/vpcompressd
+//
+
+#ifndef cspan_filter_hpp
+#define cspan_filter_hpp
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+#include "cspan_reverse.hpp"
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: in_range
+ *  Predicate lo <= value && value <= hi. cspan::filter recognises it and
+ *  runs a compress kernel for 1 and 4-byte integers.
+ */
+template<class T>
+struct in_range {
+  T lo;
+  T hi;
+
+  [[nodiscard]]
+  constexpr bool operator()(T const value) const noexcept {
+    return lo <= value && value <= hi;
+  }
+};
+
+template<class T>
+in_range(T, T) -> in_range<T>;
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace detail {
+
+//  in_range<T> over a span of T, T a 1 or 4-byte integer: the cases with
+//  a SIMD kernel.
+template<class T, class U, class Pred>
+inline constexpr bool is_range_filter_v
+  = std::is_same_v<std::remove_cv_t<T>, U>
+  && std::is_same_v<Pred, in_range<U>>
+  && std::is_integral_v<U> && !std::is_same_v<U, bool>
+  && (sizeof(U) == 1U || sizeof(U) == 4U);
+
+//  Row m holds the positions of the set bits of m, in order, then zeros:
+//  a pshufb / vpermd index that packs the selected lanes of 8 to the front.
+inline constexpr auto compress_lut = [] {
+  std::array<std::array<std::uint8_t, 8U>, 256U> lut {};
+  for (std::size_t mask { 0U }; mask != 256U; ++mask) {
+    std::size_t at { 0U };
+    for (std::uint8_t bit { 0U }; bit != 8U; ++bit) {
+      if ((mask >> bit) & 1U) {
+        lut[mask][at++] = bit;
+      }
+    }
+  }
+  return lut;
+}();
+
+#if (CSPAN_HAS_TARGET)
+//  MARK: filter_range_avx2() / filter_range_avx512()
+//  Compact the elements of in[0, count) with (x - lo) <= span (unsigned,
+//  wrapping: lo <= x <= hi) to the front of out. Every store is a full
+//  register at the write cursor, which never passes the read cursor, so
+//  out.size() >= in.size() is all the room needed. Both cursors advance
+//  by whole registers; returns { elements read, elements written }.
+struct filter_progress {
+  std::size_t read;
+  std::size_t written;
+};
+
+template<std::size_t Size, class U>
+CSPAN_TARGET("avx2,popcnt")
+filter_progress filter_range_avx2(U const * in, std::size_t const count, U * out,
+                                  U const lo, U const span) {
+  std::size_t ix { 0U };
+  std::size_t ox { 0U };
+  if constexpr (Size == 1U) {
+    auto const base = _mm256_set1_epi8(static_cast<char>(lo));
+    auto const top = _mm256_set1_epi8(static_cast<char>(span));
+    auto const src = reinterpret_cast<unsigned char const *>(in);
+    auto const dst = reinterpret_cast<unsigned char *>(out);
+    for (; ix + 32U <= count; ix += 32U) {
+      auto const dif = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + ix)), base);
+      auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(dif, top), dif)));
+      for (std::size_t group { 0U }; group != 32U; group += 8U, mask >>= 8U) {
+        auto const bits = mask & 0xFFU;
+        auto const bytes = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(src + ix + group));
+        auto const index = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(compress_lut[bits].data()));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + ox), _mm_shuffle_epi8(bytes, index));
+        ox += static_cast<std::size_t>(__builtin_popcount(bits));
+      }
+    }
+  }
+  else {
+    auto const base = _mm256_set1_epi32(static_cast<std::int32_t>(lo));
+    auto const top = _mm256_set1_epi32(static_cast<std::int32_t>(span));
+    for (; ix + 8U <= count; ix += 8U) {
+      auto const vec = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + ix));
+      auto const dif = _mm256_sub_epi32(vec, base);
+      auto const bits = static_cast<std::uint32_t>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_min_epu32(dif, top), dif))));
+      auto const index = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<__m128i const *>(compress_lut[bits].data())));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + ox), _mm256_permutevar8x32_epi32(vec, index));
+      ox += static_cast<std::size_t>(__builtin_popcount(bits));
+    }
+  }
+  return { ix, ox };
+}
+
+template<std::size_t Size, class U>
+CSPAN_TARGET("avx512f,popcnt")
+filter_progress filter_range_avx512(U const * in, std::size_t const count, U * out,
+                                    U const lo, U const span) {
+  std::size_t ix { 0U };
+  std::size_t ox { 0U };
+  if constexpr (Size == 1U) {
+    //  No byte compress without VBMI2: widen 16 bytes to dwords, compress,
+    //  narrow back with vpmovdb.
+    auto const base = _mm512_set1_epi32(static_cast<std::uint8_t>(lo));
+    auto const top = _mm512_set1_epi32(static_cast<std::uint8_t>(span));
+    auto const low = _mm512_set1_epi32(0xFF);
+    auto const src = reinterpret_cast<unsigned char const *>(in);
+    auto const dst = reinterpret_cast<unsigned char *>(out);
+    for (; ix + 16U <= count; ix += 16U) {
+      auto const vec = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + ix)));
+      auto const keep = _mm512_cmple_epu32_mask(_mm512_and_si512(_mm512_sub_epi32(vec, base), low), top);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + ox),
+                       _mm512_maskz_cvtepi32_epi8(0xFFFF, _mm512_maskz_compress_epi32(keep, vec)));
+      ox += static_cast<std::size_t>(__builtin_popcount(keep));
+    }
+  }
+  else {
+    auto const base = _mm512_set1_epi32(static_cast<std::int32_t>(lo));
+    auto const top = _mm512_set1_epi32(static_cast<std::int32_t>(span));
+    for (; ix + 16U <= count; ix += 16U) {
+      auto const vec = _mm512_loadu_si512(in + ix);
+      auto const keep = _mm512_cmple_epu32_mask(_mm512_sub_epi32(vec, base), top);
+      _mm512_storeu_si512(out + ox, _mm512_maskz_compress_epi32(keep, vec));
+      ox += static_cast<std::size_t>(__builtin_popcount(keep));
+    }
+  }
+  return { ix, ox };
+}
+#endif  /* (CSPAN_HAS_TARGET) */
+
+//  MARK: filter_scalar()
+//  Write-then-advance: every element is stored at the cursor and the cursor
+//  moves by pred(x), so there is no data-dependent branch. Types that are
+//  expensive to copy keep the branch instead.
+template<class T, class U, class Pred>
+constexpr std::size_t filter_scalar(T const * in, std::size_t const count, U * out,
+                                    Pred & pred) {
+  std::size_t ox { 0U };
+  if constexpr (std::is_trivially_copyable_v<U> && sizeof(U) <= 16U) {
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      out[ox] = in[ix];
+      ox += pred(in[ix]) ? 1U : 0U;
+    }
+  }
+  else {
+    for (std::size_t ix { 0U }; ix != count; ++ix) {
+      if (pred(in[ix])) {
+        out[ox++] = in[ix];
+      }
+    }
+  }
+  return ox;
+}
+
+//  MARK: filter_run()
+template<class T, class U, class Pred>
+constexpr std::size_t filter_run(T const * in, std::size_t const count, U * out, Pred & pred) {
+#if (CSPAN_HAS_TARGET)
+  if constexpr (is_range_filter_v<T, U, Pred>) {
+    if (!std::is_constant_evaluated()) {
+      if (pred.hi < pred.lo) {
+        return 0U;
+      }
+      using W = std::make_unsigned_t<U>;
+      auto const span = static_cast<U>(static_cast<W>(pred.hi) - static_cast<W>(pred.lo));
+      filter_progress done { 0U, 0U };
+      if (cpu().avx512f) {
+        done = filter_range_avx512<sizeof(U)>(in, count, out, pred.lo, span);
+      }
+      else if (cpu().avx2) {
+        done = filter_range_avx2<sizeof(U)>(in, count, out, pred.lo, span);
+      }
+      return done.written
+        + filter_scalar(in + done.read, count - done.read, out + done.written, pred);
+    }
+  }
+#endif  /* (CSPAN_HAS_TARGET) */
+  return filter_scalar(in, count, out, pred);
+}
+
+} /* namespace detail */
+
+//  MARK: filter()
+//  Copy the elements of `in` satisfying `pred` to the front of `out`, in
+//  order, and return the written subspan. `out` must be at least as large
+//  as `in`: every element is stored before the predicate decides whether
+//  the cursor keeps it.
+template<class T, std::size_t N, class U, std::size_t M, class Pred>
+constexpr std::span<U> filter(std::span<T, N> in, std::span<U, M> out, Pred pred) {
+  assert(out.size() >= in.size());
+  auto const written = detail::filter_run(in.data(), in.size(), out.data(), pred);
+  return std::span<U> { out.data(), written };
+}
+
+//  MARK: filter_reverse()
+//  As filter(), but in reverse order: the output of
+//  std::copy_if(in.rbegin(), in.rend(), out, pred). Range predicates are
+//  filtered forwards by the SIMD kernel, then the result is reversed.
+template<class T, std::size_t N, class U, std::size_t M, class Pred>
+constexpr std::span<U> filter_reverse(std::span<T, N> in, std::span<U, M> out, Pred pred) {
+  assert(out.size() >= in.size());
+  if constexpr (detail::is_range_filter_v<T, U, Pred>) {
+    if (!std::is_constant_evaluated()) {
+      auto const written = detail::filter_run(in.data(), in.size(), out.data(), pred);
+      detail::reverse_run(out.data(), written);
+      return std::span<U> { out.data(), written };
+    }
+  }
+  std::size_t ox { 0U };
+  for (auto ix = in.size(); ix-- != 0U; ) {
+    if constexpr (std::is_trivially_copyable_v<U> && sizeof(U) <= 16U) {
+      out[ox] = in[ix];
+      ox += pred(in[ix]) ? 1U : 0U;
+    }
+    else if (pred(in[ix])) {
+      out[ox++] = in[ix];
+    }
+  }
+  return std::span<U> { out.data(), ox };
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_filter_hpp */
@@ -0,0 +1,232 @@
+//
+//  cspan_format.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/utility/to_chars
+//  @see: https://en.cppreference.com/w/cpp/io/basic_ostream/write
+//
+
+#ifndef cspan_format_hpp
+#define cspan_format_hpp
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: format_options
+ *  How format_to() renders a span: each element right-aligned in `width`
+ *  columns padded with `fill`, elements joined by `separator`, the whole
+ *  wrapped in `open` / `close`. Integers (and std::byte, enums) print in
+ *  `base`; floating-point values in the shortest round-trip form, or
+ *  like iostreams' default with `precision` significant digits when
+ *  precision >= 0 (at most field_max - 8, so every value fits a field).
+ *  char elements print as characters, signed / unsigned char as numbers;
+ *  anything convertible to std::string_view as text.
+ *  Negative integers print in hex as sign and magnitude (-1 is "-1", -255
+ *  is "-ff"), not as iostreams' two's complement "ffffffff".
+ */
+enum class base {
+  dec,
+  hex,
+};
+
+struct format_options {
+  cspan::base base { base::dec };
+  bool uppercase { false };
+  std::size_t width { 0U };
+  char fill { ' ' };
+  int precision { -1 };
+  std::string_view separator { " " };
+  std::string_view open {};
+  std::string_view close {};
+};
+
+/*
+ *  MARK: format_buffer
+ *  Characters accumulate in caller-provided storage and reach `sink` in a
+ *  single write() per flush: when the storage fills, on flush(), and on
+ *  destruction. Nothing is allocated.
+ */
+class format_buffer {
+public:
+  //  Longest formatted scalar: 64 binary digits' worth of decimal / hex,
+  //  or a floating-point value, plus sign.
+  static std::size_t constexpr field_max { 64U };
+
+  explicit format_buffer(std::span<char> storage, std::ostream & sink = std::cout)
+    : storage_ { storage }, sink_ { &sink } {
+    assert(storage_.size() >= 2U * field_max);
+  }
+
+  format_buffer(format_buffer const &) = delete;
+  format_buffer & operator=(format_buffer const &) = delete;
+
+  ~format_buffer() { flush(); }
+
+  void flush() {
+    if (size_ != 0U) {
+      sink_->write(storage_.data(), static_cast<std::streamsize>(size_));
+      size_ = 0U;
+    }
+  }
+
+  //  Characters waiting for the next flush.
+  [[nodiscard]]
+  std::string_view view() const noexcept { return { storage_.data(), size_ }; }
+
+  format_buffer & append(char const chr) {
+    reserve(1U);
+    storage_[size_++] = chr;
+    return *this;
+  }
+
+  format_buffer & append(std::string_view text) {
+    if (text.size() <= storage_.size() - size_) {
+      std::copy(text.begin(), text.end(), storage_.data() + size_);
+      size_ += text.size();
+      return *this;
+    }
+    while (text.size() > storage_.size() - size_) {
+      auto const part = storage_.size() - size_;
+      std::copy_n(text.data(), part, storage_.data() + size_);
+      size_ += part;
+      text.remove_prefix(part);
+      flush();
+    }
+    std::copy(text.begin(), text.end(), storage_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+
+  //  One element, formatted per `options` (open / close / separator unused).
+  template<class T>
+  format_buffer & append(T const & value, format_options const & options) {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, char>) {
+      return pad(options, 1U).append(value);
+    }
+    else if constexpr (std::is_convertible_v<T const &, std::string_view>) {
+      std::string_view const text { value };
+      return pad(options, text.size()).append(text);
+    }
+    else if (options.width > field_max) {
+      std::array<char, field_max> digits;
+      auto const length = to_chars(digits.data(), digits.data() + field_max, value, options);
+      return pad(options, length).append(std::string_view { digits.data(), length });
+    }
+    else {
+      //  Format in place, then shift right into the field if it is short.
+      reserve(field_max);
+      auto const at = storage_.data() + size_;
+      auto const length = to_chars(at, at + field_max, value, options);
+      if (options.width > length) {
+        auto const gap = options.width - length;
+        std::copy_backward(at, at + length, at + options.width);
+        std::fill_n(at, gap, options.fill);
+        size_ += options.width;
+      }
+      else {
+        size_ += length;
+      }
+      return *this;
+    }
+  }
+
+private:
+  void reserve(std::size_t const count) {
+    if (count > storage_.size() - size_) {
+      flush();
+    }
+  }
+
+  format_buffer & pad(format_options const & options, std::size_t const length) {
+    for (auto count = options.width > length ? options.width - length : 0U; count != 0U; ) {
+      reserve(1U);
+      auto const part = std::min(count, storage_.size() - size_);
+      std::fill_n(storage_.data() + size_, part, options.fill);
+      size_ += part;
+      count -= part;
+    }
+    return *this;
+  }
+
+  template<class T>
+  static std::size_t to_chars(char * const first, char * const last, T const & value,
+                              format_options const & options) {
+    std::to_chars_result done;
+    if constexpr (std::is_same_v<T, std::byte> || std::is_enum_v<T>) {
+      return to_chars(first, last, static_cast<std::underlying_type_t<T>>(value), options);
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+      return to_chars(first, last, static_cast<int>(value), options);
+    }
+    else if constexpr (std::is_integral_v<T>) {
+      done = std::to_chars(first, last, value, options.base == base::hex ? 16 : 10);
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+      //  The longest general form is sign, digits, '.' and "e+4932".
+      int constexpr precision_max { static_cast<int>(field_max) - 8 };
+      done = options.precision < 0
+        ? std::to_chars(first, last, value)
+        : std::to_chars(first, last, value, std::chars_format::general,
+                        std::min(options.precision, precision_max));
+      if (done.ec != std::errc {}) {
+        done = std::to_chars(first, last, value);
+      }
+    }
+    else {
+      static_assert(std::is_arithmetic_v<T>, "format_buffer: no formatting for this type");
+    }
+    //  Every scalar fits field_max characters.
+    assert(done.ec == std::errc {});
+    if (options.uppercase) {
+      std::transform(first, done.ptr, first, [](char const chr) {
+        return chr >= 'a' && chr <= 'z' ? static_cast<char>(chr - 'a' + 'A') : chr;
+      });
+    }
+    return static_cast<std::size_t>(done.ptr - first);
+  }
+
+  std::span<char> storage_;
+  std::ostream * sink_;
+  std::size_t size_ { 0U };
+};
+
+//  MARK: thread_format_storage()
+//  64 KiB of per-thread storage for a format_buffer; one buffer at a time.
+[[nodiscard]]
+inline std::span<char> thread_format_storage() {
+  thread_local std::array<char, 64U << 10U> storage;
+  return storage;
+}
+
+//  MARK: format_to()
+template<class T, std::size_t N>
+format_buffer & format_to(format_buffer & buffer, std::span<T, N> span,
+                          format_options const & options = {}) {
+  buffer.append(options.open);
+  for (std::size_t ix { 0U }; ix != span.size(); ++ix) {
+    if (ix != 0U) {
+      buffer.append(options.separator);
+    }
+    buffer.append(span[ix], options);
+  }
+  return buffer.append(options.close);
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_format_hpp */
@@ -0,0 +1,551 @@
+//
+//  cspan_hash.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://github.com/wangyi-fudan/wyhash
+//  @see: https://www.rfc-editor.org/rfc/rfc3720#appendix-B.4
+//  @see: https://en.wikipedia.org/wiki/Rabin%E2%80%93Karp_algorithm
+//  @see: https://en.wikipedia.org/wiki/Rolling_hash#Content-based_slicing_using_a_rolling_hash
+//
+
+#ifndef cspan_hash_hpp
+#define cspan_hash_hpp
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+#include "cspan_rolling.hpp"
+#include "cspan_view_as.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  MARK: wyhash primitives
+inline constexpr std::uint64_t wy_secret[4] {
+  0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL,
+};
+
+//  64 x 64 -> 128-bit multiply: lhs = low half, rhs = high half.
+CSPAN_ALWAYS_INLINE void wy_mum(std::uint64_t & lhs, std::uint64_t & rhs) noexcept {
+#if (defined(__SIZEOF_INT128__))
+  __extension__ typedef unsigned __int128 uint128;
+  auto const product = static_cast<uint128>(lhs) * rhs;
+  lhs = static_cast<std::uint64_t>(product);
+  rhs = static_cast<std::uint64_t>(product >> 64U);
+#else
+  auto const lhs_hi = lhs >> 32U;
+  auto const lhs_lo = lhs & 0xffff'ffffULL;
+  auto const rhs_hi = rhs >> 32U;
+  auto const rhs_lo = rhs & 0xffff'ffffULL;
+  auto const hi_hi = lhs_hi * rhs_hi;
+  auto const hi_lo = lhs_hi * rhs_lo;
+  auto const lo_hi = lhs_lo * rhs_hi;
+  auto const lo_lo = lhs_lo * rhs_lo;
+  auto const mid = lo_lo + (hi_lo << 32U);
+  auto const low = mid + (lo_hi << 32U);
+  auto const carry = static_cast<std::uint64_t>(mid < lo_lo) + static_cast<std::uint64_t>(low < mid);
+  lhs = low;
+  rhs = hi_hi + (hi_lo >> 32U) + (lo_hi >> 32U) + carry;
+#endif  /* (defined(__SIZEOF_INT128__)) */
+}
+
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE std::uint64_t wy_mix(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+  wy_mum(lhs, rhs);
+  return lhs ^ rhs;
+}
+
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE std::uint64_t wy_r8(std::byte const * const src) noexcept {
+  return load<std::uint64_t, std::endian::little>(src);
+}
+
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE std::uint64_t wy_r4(std::byte const * const src) noexcept {
+  return load<std::uint32_t, std::endian::little>(src);
+}
+
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE std::uint64_t wy_r3(std::byte const * const src, std::size_t const size) noexcept {
+  return (std::to_integer<std::uint64_t>(src[0U]) << 16U)
+    | (std::to_integer<std::uint64_t>(src[size >> 1U]) << 8U)
+    | std::to_integer<std::uint64_t>(src[size - 1U]);
+}
+
+//  One 48-byte stripe into the three lanes.
+CSPAN_ALWAYS_INLINE void wy_stripe(std::byte const * const src, std::uint64_t & seed,
+                                   std::uint64_t & see1, std::uint64_t & see2) noexcept {
+  seed = wy_mix(wy_r8(src) ^ wy_secret[1], wy_r8(src + 8U) ^ seed);
+  see1 = wy_mix(wy_r8(src + 16U) ^ wy_secret[2], wy_r8(src + 24U) ^ see1);
+  see2 = wy_mix(wy_r8(src + 32U) ^ wy_secret[3], wy_r8(src + 40U) ^ see2);
+}
+
+//  The last `rest` (<= 48) bytes at `src` of a `size`-byte input. For
+//  size > 16 the 16 bytes before `src` must be readable (the final read
+//  may reach back into them).
+[[nodiscard]]
+inline std::uint64_t wy_finish(std::byte const * src, std::size_t rest, std::size_t const size,
+                               std::uint64_t seed) noexcept {
+  std::uint64_t lhs;
+  std::uint64_t rhs;
+  if (size <= 16U) {
+    if (size >= 4U) {
+      auto const step = (size >> 3U) << 2U;
+      lhs = (wy_r4(src) << 32U) | wy_r4(src + step);
+      rhs = (wy_r4(src + size - 4U) << 32U) | wy_r4(src + size - 4U - step);
+    }
+    else if (size > 0U) {
+      lhs = wy_r3(src, size);
+      rhs = 0U;
+    }
+    else {
+      lhs = 0U;
+      rhs = 0U;
+    }
+  }
+  else {
+    while (rest > 16U) {
+      seed = wy_mix(wy_r8(src) ^ wy_secret[1], wy_r8(src + 8U) ^ seed);
+      src += 16U;
+      rest -= 16U;
+    }
+    lhs = wy_r8(src + rest - 16U);
+    rhs = wy_r8(src + rest - 8U);
+  }
+  lhs ^= wy_secret[1];
+  rhs ^= seed;
+  wy_mum(lhs, rhs);
+  return wy_mix(lhs ^ wy_secret[0] ^ size, rhs ^ wy_secret[1]);
+}
+
+//  MARK: crc32c tables
+//  Slicing-by-8 tables for the reflected Castagnoli polynomial.
+inline constexpr std::uint32_t crc32c_poly { 0x82f6'3b78U };
+
+[[nodiscard]]
+constexpr auto make_crc32c_tables() noexcept {
+  std::array<std::array<std::uint32_t, 256U>, 8U> table {};
+  for (std::uint32_t byte { 0U }; byte != 256U; ++byte) {
+    auto crc = byte;
+    for (int bit { 0 }; bit != 8; ++bit) {
+      crc = (crc >> 1U) ^ ((crc & 1U) != 0U ? crc32c_poly : 0U);
+    }
+    table[0U][byte] = crc;
+  }
+  for (std::size_t slice { 1U }; slice != 8U; ++slice) {
+    for (std::size_t byte { 0U }; byte != 256U; ++byte) {
+      auto const prev = table[slice - 1U][byte];
+      table[slice][byte] = (prev >> 8U) ^ table[0U][prev & 0xffU];
+    }
+  }
+  return table;
+}
+
+inline constexpr auto crc32c_table = make_crc32c_tables();
+
+//  MARK: crc32c_scalar()
+//  Raw register update (no pre / post inversion), eight bytes per step.
+[[nodiscard]]
+inline std::uint32_t crc32c_scalar(std::uint32_t crc, std::byte const * src, std::size_t size) noexcept {
+  auto const & tab = crc32c_table;
+  for (; size >= 8U; size -= 8U, src += 8U) {
+    auto const word = load<std::uint64_t, std::endian::little>(src) ^ crc;
+    crc = tab[7U][word & 0xffU] ^ tab[6U][(word >> 8U) & 0xffU]
+      ^ tab[5U][(word >> 16U) & 0xffU] ^ tab[4U][(word >> 24U) & 0xffU]
+      ^ tab[3U][(word >> 32U) & 0xffU] ^ tab[2U][(word >> 40U) & 0xffU]
+      ^ tab[1U][(word >> 48U) & 0xffU] ^ tab[0U][word >> 56U];
+  }
+  for (; size != 0U; --size, ++src) {
+    crc = (crc >> 8U) ^ tab[0U][(crc ^ std::to_integer<std::uint32_t>(*src)) & 0xffU];
+  }
+  return crc;
+}
+
+#if (CSPAN_HAS_TARGET)
+//  Bytes per stream in the 3-way SSE4.2 kernel.
+inline constexpr std::size_t crc32c_stream { 1'024U };
+
+/*
+ *  MARK: crc32c_shift_table()
+ *  The register after crc32c_stream zero bytes, as four byte tables:
+ *  CRC is linear, so reg(s, A || B) = shift(reg(s, A)) ^ reg(0, B) with
+ *  |B| = crc32c_stream. Built once, on first use.
+ */
+[[nodiscard]]
+inline auto crc32c_shift_table() -> std::array<std::array<std::uint32_t, 256U>, 4U> const & {
+  static auto const table = [] {
+    std::array<std::array<std::uint32_t, 256U>, 4U> tab {};
+    std::array<std::byte, crc32c_stream> const zeros {};
+    for (std::size_t lane { 0U }; lane != 4U; ++lane) {
+      for (std::uint32_t byte { 0U }; byte != 256U; ++byte) {
+        tab[lane][byte] = crc32c_scalar(byte << (8U * lane), zeros.data(), zeros.size());
+      }
+    }
+    return tab;
+  }();
+  return table;
+}
+
+//  MARK: crc32c_sse42()
+//  The crc32 instruction has a 3-cycle latency and 1-cycle throughput:
+//  three independent streams keep it busy, then are combined by shifting.
+CSPAN_TARGET("sse4.2")
+inline std::uint32_t crc32c_sse42(std::uint32_t const crc, std::byte const * src, std::size_t size) noexcept {
+  std::uint64_t crc0 { crc };
+  auto const shift = size >= 3U * crc32c_stream ? &crc32c_shift_table() : nullptr;
+  for (; size >= 3U * crc32c_stream; size -= 3U * crc32c_stream, src += 3U * crc32c_stream) {
+    std::uint64_t crc1 { 0U };
+    std::uint64_t crc2 { 0U };
+    for (std::size_t ix { 0U }; ix != crc32c_stream; ix += 8U) {
+      crc0 = _mm_crc32_u64(crc0, load<std::uint64_t, std::endian::little>(src + ix));
+      crc1 = _mm_crc32_u64(crc1, load<std::uint64_t, std::endian::little>(src + crc32c_stream + ix));
+      crc2 = _mm_crc32_u64(crc2, load<std::uint64_t, std::endian::little>(src + 2U * crc32c_stream + ix));
+    }
+    auto const & tab = *shift;
+    auto const move = [&tab](std::uint64_t const reg) {
+      return std::uint64_t { tab[0U][reg & 0xffU] ^ tab[1U][(reg >> 8U) & 0xffU]
+        ^ tab[2U][(reg >> 16U) & 0xffU] ^ tab[3U][(reg >> 24U) & 0xffU] };
+    };
+    crc0 = move(move(crc0) ^ crc1) ^ crc2;
+  }
+  for (; size >= 8U; size -= 8U, src += 8U) {
+    crc0 = _mm_crc32_u64(crc0, load<std::uint64_t, std::endian::little>(src));
+  }
+  auto crc32 = static_cast<std::uint32_t>(crc0);
+  for (; size != 0U; --size, ++src) {
+    crc32 = _mm_crc32_u8(crc32, std::to_integer<std::uint8_t>(*src));
+  }
+  return crc32;
+}
+#endif  /* (CSPAN_HAS_TARGET) */
+
+//  Byte -> random 64-bit value (splitmix64), so runs of equal bytes do
+//  not give degenerate rolling hashes.
+[[nodiscard]]
+constexpr auto make_rabin_karp_table() noexcept {
+  std::array<std::uint64_t, 256U> table {};
+  std::uint64_t state { 0x9e37'79b9'7f4a'7c15ULL };
+  for (auto & value : table) {
+    state += 0x9e37'79b9'7f4a'7c15ULL;
+    auto mix = state;
+    mix = (mix ^ (mix >> 30U)) * 0xbf58'476d'1ce4'e5b9ULL;
+    mix = (mix ^ (mix >> 27U)) * 0x94d0'49bb'1331'11ebULL;
+    value = mix ^ (mix >> 31U);
+  }
+  return table;
+}
+
+inline constexpr auto rabin_karp_table = make_rabin_karp_table();
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+
+/*
+ *  MARK: hash()
+ *  64-bit wyhash (final 4 construction) of `bytes`: a 128-bit multiply-mix
+ *  over 48-byte stripes in three independent lanes. Not cryptographic;
+ *  for hash tables, deduplication and change detection.
+ */
+[[nodiscard]]
+inline std::uint64_t hash(std::span<std::byte const> const bytes, std::uint64_t seed = 0U) noexcept {
+  auto src = bytes.data();
+  auto rest = bytes.size();
+  seed ^= detail::wy_mix(seed ^ detail::wy_secret[0], detail::wy_secret[1]);
+  if (rest > 48U) {
+    auto see1 = seed;
+    auto see2 = seed;
+    do {
+      detail::wy_stripe(src, seed, see1, see2);
+      src += 48U;
+      rest -= 48U;
+    } while (rest > 48U);
+    seed ^= see1 ^ see2;
+  }
+  return detail::wy_finish(src, rest, bytes.size(), seed);
+}
+
+/*
+ *  MARK: hasher
+ *  hash() fed in pieces: update() any number of times, then digest()
+ *  equals hash() of the concatenated bytes, however they were split.
+ *  update_each() feeds every span of a range, e.g. the output of
+ *  cspan::chunks(); digest() does not end the stream.
+ */
+class hasher {
+public:
+  explicit hasher(std::uint64_t const seed = 0U) noexcept
+    : seed_ { seed ^ detail::wy_mix(seed ^ detail::wy_secret[0], detail::wy_secret[1]) } {}
+
+  hasher & update(std::span<std::byte const> bytes) noexcept {
+    size_ += bytes.size();
+    //  The pending bytes, then the room left for more. pending_ never
+    //  exceeds a stripe; the min() lets the compiler see that too.
+    assert(pending_ <= stripe);
+    auto const tail = std::span { buffer_ }.subspan<history>();
+    auto const free = tail.subspan(std::min(pending_, stripe));
+    //  A stripe is only consumed once a byte after it is known to exist:
+    //  hash() treats the final 1 .. 48 bytes differently.
+    if (bytes.size() <= free.size()) {
+      std::copy(bytes.begin(), bytes.end(), free.begin());
+      pending_ += bytes.size();
+      return *this;
+    }
+    if (!wide_) {
+      see1_ = seed_;
+      see2_ = seed_;
+      wide_ = true;
+    }
+    std::byte const * last { nullptr };
+    if (pending_ != 0U) {
+      std::copy_n(bytes.begin(), free.size(), free.begin());
+      bytes = bytes.subspan(free.size());
+      detail::wy_stripe(tail.data(), seed_, see1_, see2_);
+      last = tail.data();
+      pending_ = 0U;
+    }
+    for (; bytes.size() > stripe; bytes = bytes.subspan(stripe)) {
+      detail::wy_stripe(bytes.data(), seed_, see1_, see2_);
+      last = bytes.data();
+    }
+    std::memmove(buffer_.data(), last + stripe - history, history);
+    assert(bytes.size() <= stripe);
+    std::copy(bytes.begin(), bytes.end(), tail.begin());
+    pending_ = bytes.size();
+    return *this;
+  }
+
+  template<class Range>
+  hasher & update_each(Range const & parts) noexcept {
+    for (auto const & part : parts) {
+      update(std::as_bytes(std::span { part }));
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::uint64_t digest() const noexcept {
+    auto const seed = wide_ ? seed_ ^ see1_ ^ see2_ : seed_;
+    return detail::wy_finish(buffer_.data() + history, pending_, size_, seed);
+  }
+
+  [[nodiscard]]
+  std::uint64_t size() const noexcept { return size_; }
+
+private:
+  static std::size_t constexpr stripe { 48U };
+  static std::size_t constexpr history { 16U };
+
+  //  The last `history` consumed bytes, then up to `stripe` pending ones.
+  std::array<std::byte, history + stripe> buffer_ {};
+  std::size_t pending_ { 0U };
+  std::uint64_t size_ { 0U };
+  std::uint64_t seed_;
+  std::uint64_t see1_ { 0U };
+  std::uint64_t see2_ { 0U };
+  bool wide_ { false };
+};
+
+/*
+ *  MARK: crc32c()
+ *  CRC-32C (Castagnoli, as in iSCSI, ext4, SCTP). Chains:
+ *    crc32c(b, crc32c(a)) == crc32c(a followed by b).
+ *  SSE4.2 hardware CRC on CPUs that have it, slicing-by-8 tables
+ *  elsewhere.
+ */
+[[nodiscard]]
+inline std::uint32_t crc32c(std::span<std::byte const> const bytes, std::uint32_t const crc = 0U) noexcept {
+#if (CSPAN_HAS_TARGET)
+  if (cpu().sse42) {
+    return ~detail::crc32c_sse42(~crc, bytes.data(), bytes.size());
+  }
+#endif  /* (CSPAN_HAS_TARGET) */
+  return ~detail::crc32c_scalar(~crc, bytes.data(), bytes.size());
+}
+
+/*
+ *  MARK: rabin_karp
+ *  Polynomial rolling hash over a `width`-byte window, mod 2^64: sliding
+ *  one byte is a multiply, an add and a subtract (the outgoing byte's
+ *  term comes from a table). Each byte enters through a fixed random
+ *  64-bit value.
+ */
+class rabin_karp {
+public:
+  static std::uint64_t constexpr base { 0x0000'0100'0000'01b3ULL };
+
+  explicit rabin_karp(std::size_t const width) noexcept : width_ { width } {
+    assert(width != 0U);
+    std::uint64_t power { 1U };
+    for (std::size_t ix { 0U }; ix != width; ++ix) {
+      power *= base;
+    }
+    for (std::size_t byte { 0U }; byte != 256U; ++byte) {
+      drop_[byte] = detail::rabin_karp_table[byte] * power;
+    }
+  }
+
+  [[nodiscard]]
+  std::size_t width() const noexcept { return width_; }
+
+  [[nodiscard]]
+  std::uint64_t value() const noexcept { return value_; }
+
+  //  Hash of exactly width() bytes; rolling continues from it.
+  std::uint64_t prime(std::span<std::byte const> const window) noexcept {
+    assert(window.size() == width_);
+    value_ = 0U;
+    for (auto const byte : window) {
+      value_ = value_ * base + detail::rabin_karp_table[std::to_integer<std::uint8_t>(byte)];
+    }
+    return value_;
+  }
+
+  //  Slide one byte: `out` leaves the window, `in` enters it.
+  std::uint64_t roll(std::byte const out, std::byte const in) noexcept {
+    value_ = value_ * base + detail::rabin_karp_table[std::to_integer<std::uint8_t>(in)]
+      - drop_[std::to_integer<std::uint8_t>(out)];
+    return value_;
+  }
+
+private:
+  std::size_t width_;
+  std::uint64_t value_ { 0U };
+  std::array<std::uint64_t, 256U> drop_;
+};
+
+//  MARK: rolling_hash()
+//  The rabin_karp hash of every `width`-byte window of `in`; same
+//  contract as rolling_sum().
+template<std::size_t N, std::size_t M>
+std::span<std::uint64_t> rolling_hash(std::span<std::byte const, N> const in, std::size_t const width,
+                                      std::span<std::uint64_t, M> const out) {
+  assert(width != 0U);
+  auto const count = detail::window_count(in.size(), width);
+  assert(out.size() >= count);
+  if (count == 0U) {
+    return std::span<std::uint64_t> { out }.first(0U);
+  }
+  rabin_karp roller { width };
+  out[0U] = roller.prime(in.first(width));
+  for (std::size_t ix { 1U }; ix != count; ++ix) {
+    out[ix] = roller.roll(in[ix - 1U], in[ix + width - 1U]);
+  }
+  return std::span<std::uint64_t> { out }.first(count);
+}
+
+/*
+ *  MARK: content_chunks()
+ *  Content-defined chunking: a chunk ends after the first window (of
+ *  `window` bytes) whose rabin_karp hash has its top log2(avg_size -
+ *  min_size) bits clear (with avg_size - min_size == 1 that is zero bits,
+ *  so every chunk is min_size), but never before min_size or after
+ *  max_size bytes. Boundaries depend only on nearby content, so an
+ *  insertion moves the chunks around it and leaves the rest identical:
+ *  the basis of deduplicating storage. Iterating yields
+ *  std::span<std::byte const>.
+ */
+struct chunk_options {
+  std::size_t min_size { 4U << 10U };
+  std::size_t avg_size { 8U << 10U };
+  std::size_t max_size { 64U << 10U };
+  std::size_t window { 48U };
+};
+
+class content_chunk_range {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::span<std::byte const>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::span<std::byte const>;
+
+    iterator() noexcept = default;
+    iterator(content_chunk_range const * const range, std::span<std::byte const> const rest) noexcept
+      : range_ { range }, rest_ { rest } {
+      chunk_ = rest_.first(range_ != nullptr ? range_->cut(rest_) : 0U);
+    }
+
+    [[nodiscard]]
+    reference operator*() const noexcept { return chunk_; }
+
+    iterator & operator++() noexcept {
+      rest_ = rest_.subspan(chunk_.size());
+      chunk_ = rest_.first(range_->cut(rest_));
+      return *this;
+    }
+    iterator operator++(int) noexcept { auto const was = *this; ++*this; return was; }
+
+    [[nodiscard]]
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept {
+      return lhs.rest_.size() == rhs.rest_.size();
+    }
+
+  private:
+    content_chunk_range const * range_ { nullptr };
+    std::span<std::byte const> rest_ {};
+    std::span<std::byte const> chunk_ {};
+  };
+
+  content_chunk_range(std::span<std::byte const> const bytes, chunk_options const & options) noexcept
+    : bytes_ { bytes }, options_ { options }, roller_ { options.window },
+      bits_ { static_cast<unsigned>(std::bit_width(options.avg_size - options.min_size) - 1) } {
+    assert(options.window != 0U && options.window <= options.min_size);
+    assert(options.min_size < options.avg_size && options.avg_size <= options.max_size);
+  }
+
+  [[nodiscard]]
+  iterator begin() const noexcept { return { this, bytes_ }; }
+
+  [[nodiscard]]
+  iterator end() const noexcept { return { nullptr, bytes_.last(0U) }; }
+
+private:
+  //  Length of the chunk at the front of `rest`.
+  [[nodiscard]]
+  std::size_t cut(std::span<std::byte const> const rest) const noexcept {
+    if (rest.size() <= options_.min_size) {
+      return rest.size();
+    }
+    auto const limit = std::min(rest.size(), options_.max_size);
+    auto roller = roller_;
+    auto value = roller.prime(rest.subspan(options_.min_size - options_.window, options_.window));
+    for (auto pos = options_.min_size; pos != limit; ++pos) {
+      if (bits_ == 0U || (value >> (64U - bits_)) == 0U) {
+        return pos;
+      }
+      value = roller.roll(rest[pos - options_.window], rest[pos]);
+    }
+    return limit;
+  }
+
+  std::span<std::byte const> bytes_;
+  chunk_options options_;
+  rabin_karp roller_;
+  //  Top bits of the hash that must be clear at a boundary; 0 to 63.
+  unsigned bits_;
+};
+
+[[nodiscard]]
+inline content_chunk_range content_chunks(std::span<std::byte const> const bytes,
+                                          chunk_options const & options = {}) noexcept {
+  return { bytes, options };
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_hash_hpp */
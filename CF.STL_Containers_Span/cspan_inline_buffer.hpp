@@ -0,0 +1,306 @@
+//
+//  cspan_inline_buffer.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://llvm.org/docs/ProgrammersManual.html#llvm-adt-smallvector-h
+//  @see: https://en.cppreference.com/w/cpp/container/span/span
+//
+
+#ifndef cspan_inline_buffer_hpp
+#define cspan_inline_buffer_hpp
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "cspan_arena.hpp"
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: inline_buffer
+ *  An owning, growable sequence that keeps up to N elements inside the
+ *  object and only allocates above that: from the heap, or from an arena
+ *  given at construction (spilled arena storage is never freed by the
+ *  buffer; it goes when the arena is rewound).
+ *  An lvalue converts implicitly to std::span<T> / std::span<T const>
+ *  (it is a contiguous range), and to std::span<T, N> when it holds
+ *  exactly N elements. Moving steals spilled storage; inline elements
+ *  are moved one by one, size() of them, never all N slots.
+ *  T must be nothrow move constructible.
+ */
+template<class T, std::size_t N>
+class inline_buffer {
+  static_assert(N != 0U, "inline_buffer needs inline capacity");
+  static_assert(std::is_nothrow_move_constructible_v<T>, "inline_buffer elements must be nothrow movable");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = T const &;
+  using pointer = T *;
+  using const_pointer = T const *;
+  using iterator = T *;
+  using const_iterator = T const *;
+
+  static std::size_t constexpr inline_capacity { N };
+
+  inline_buffer() noexcept = default;
+
+  //  Spill to `spill` instead of the heap.
+  explicit inline_buffer(arena & spill) noexcept
+    : arena_ { &spill } {}
+
+  inline_buffer(std::initializer_list<T> const values) {
+    append(values.begin(), values.size());
+  }
+
+  template<class U, std::size_t M>
+    requires std::is_constructible_v<T, U const &>
+  explicit inline_buffer(std::span<U, M> const values) {
+    append(values.data(), values.size());
+  }
+
+  inline_buffer(inline_buffer const & other)
+    : arena_ { other.arena_ } {
+    append(other.data_, other.size_);
+  }
+
+  inline_buffer(inline_buffer && other) noexcept
+    : arena_ { other.arena_ } {
+    take(other);
+  }
+
+  inline_buffer & operator=(inline_buffer const & other) {
+    if (this != &other) {
+      clear();
+      append(other.data_, other.size_);
+    }
+    return *this;
+  }
+
+  inline_buffer & operator=(inline_buffer && other) noexcept {
+    if (this != &other) {
+      clear();
+      deallocate(data_, capacity_);
+      data_ = inline_data();
+      capacity_ = N;
+      arena_ = other.arena_;
+      take(other);
+    }
+    return *this;
+  }
+
+  ~inline_buffer() {
+    std::destroy_n(data_, size_);
+    deallocate(data_, capacity_);
+  }
+
+  //  MARK: access
+  [[nodiscard]]
+  T * data() noexcept { return data_; }
+
+  [[nodiscard]]
+  T const * data() const noexcept { return data_; }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]]
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return size_ == 0U; }
+
+  //  True while the elements live in the object itself.
+  [[nodiscard]]
+  bool is_inline() const noexcept { return data_ == inline_data(); }
+
+  [[nodiscard]]
+  iterator begin() noexcept { return data_; }
+
+  [[nodiscard]]
+  iterator end() noexcept { return data_ + size_; }
+
+  [[nodiscard]]
+  const_iterator begin() const noexcept { return data_; }
+
+  [[nodiscard]]
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  [[nodiscard]]
+  T & operator[](std::size_t const ix) noexcept {
+    assert(ix < size_);
+    return data_[ix];
+  }
+
+  [[nodiscard]]
+  T const & operator[](std::size_t const ix) const noexcept {
+    assert(ix < size_);
+    return data_[ix];
+  }
+
+  [[nodiscard]]
+  T & front() noexcept { return (*this)[0U]; }
+
+  [[nodiscard]]
+  T const & front() const noexcept { return (*this)[0U]; }
+
+  [[nodiscard]]
+  T & back() noexcept { return (*this)[size_ - 1U]; }
+
+  [[nodiscard]]
+  T const & back() const noexcept { return (*this)[size_ - 1U]; }
+
+  //  Exactly N elements as a fixed-extent span.
+  operator std::span<T, N>() noexcept {
+    assert(size_ == N);
+    return std::span<T, N> { data_, N };
+  }
+
+  operator std::span<T const, N>() const noexcept {
+    assert(size_ == N);
+    return std::span<T const, N> { data_, N };
+  }
+
+  //  MARK: modifiers
+  void reserve(std::size_t const capacity) {
+    if (capacity > capacity_) {
+      relocate(capacity);
+    }
+  }
+
+  template<class... Args>
+  T & emplace_back(Args &&... args) {
+    if (size_ == capacity_) [[unlikely]] {
+      emplace_grow(std::forward<Args>(args)...);
+    }
+    else {
+      std::construct_at(data_ + size_, std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(T const & value) { emplace_back(value); }
+  void push_back(T && value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept {
+    assert(size_ != 0U);
+    std::destroy_at(data_ + --size_);
+  }
+
+  //  New elements are value-initialised.
+  void resize(std::size_t const size) {
+    if (size < size_) {
+      std::destroy(data_ + size, data_ + size_);
+    }
+    else {
+      reserve(size);
+      std::uninitialized_value_construct(data_ + size_, data_ + size);
+    }
+    size_ = size;
+  }
+
+  void clear() noexcept {
+    std::destroy_n(data_, size_);
+    size_ = 0U;
+  }
+
+private:
+  [[nodiscard]]
+  T * inline_data() noexcept { return reinterpret_cast<T *>(inline_); }
+
+  [[nodiscard]]
+  T const * inline_data() const noexcept { return reinterpret_cast<T const *>(inline_); }
+
+  [[nodiscard]]
+  std::size_t grown(std::size_t const needed) const noexcept {
+    return std::max(needed, 2U * capacity_);
+  }
+
+  [[nodiscard]]
+  T * allocate(std::size_t const count) {
+    if (arena_ != nullptr) {
+      return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+    return std::allocator<T> {}.allocate(count);
+  }
+
+  void deallocate(T * const storage, std::size_t const count) noexcept {
+    if (storage != inline_data() && arena_ == nullptr) {
+      std::allocator<T> {}.deallocate(storage, count);
+    }
+  }
+
+  //  Out of line, so emplace_back stays small. The new element is built
+  //  first: args may refer to an old one.
+  template<class... Args>
+  void emplace_grow(Args &&... args) {
+    auto const capacity = grown(size_ + 1U);
+    auto * const fresh = allocate(capacity);
+    try {
+      std::construct_at(fresh + size_, std::forward<Args>(args)...);
+    }
+    catch (...) {
+      deallocate(fresh, capacity);
+      throw;
+    }
+    std::uninitialized_move_n(data_, size_, fresh);
+    std::destroy_n(data_, size_);
+    deallocate(data_, capacity_);
+    data_ = fresh;
+    capacity_ = capacity;
+  }
+
+  void relocate(std::size_t const capacity) {
+    auto * const fresh = allocate(capacity);
+    std::uninitialized_move_n(data_, size_, fresh);
+    std::destroy_n(data_, size_);
+    deallocate(data_, capacity_);
+    data_ = fresh;
+    capacity_ = capacity;
+  }
+
+  template<class U>
+  void append(U const * const values, std::size_t const count) {
+    reserve(size_ + count);
+    std::uninitialized_copy_n(values, count, data_ + size_);
+    size_ += count;
+  }
+
+  //  Move `other`'s elements into this (empty, inline) buffer and leave
+  //  `other` empty and inline.
+  void take(inline_buffer & other) noexcept {
+    if (other.is_inline()) {
+      std::uninitialized_move_n(other.data_, other.size_, data_);
+      std::destroy_n(other.data_, other.size_);
+      size_ = other.size_;
+    }
+    else {
+      data_ = std::exchange(other.data_, other.inline_data());
+      capacity_ = std::exchange(other.capacity_, N);
+      size_ = other.size_;
+    }
+    other.size_ = 0U;
+  }
+
+  T * data_ { inline_data() };
+  std::size_t size_ { 0U };
+  std::size_t capacity_ { N };
+  arena * arena_ { nullptr };
+  alignas(T) std::byte inline_[N * sizeof(T)];
+};
+
+} /* namespace cspan */
+
+#endif /* cspan_inline_buffer_hpp */
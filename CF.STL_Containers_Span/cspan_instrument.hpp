@@ -0,0 +1,449 @@
+//
+//  cspan_instrument.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://man7.org/linux/man-pages/man2/perf_event_open.2.html
+//  @see: https://en.cppreference.com/w/cpp/atomic/memory_order#Relaxed_ordering
+//
+
+#ifndef cspan_instrument_hpp
+#define cspan_instrument_hpp
+
+//  MARK: - Configuration.
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+//  -DCSPAN_INSTRUMENT=1 turns the hooks on; otherwise CSPAN_PROBE() and
+//  CSPAN_RESULT() expand to nothing but the result expression and this
+//  header declares nothing else.
+//  -DCSPAN_INSTRUMENT_PERF=1 (Linux) adds hardware cycle and cache-miss
+//  counts per call, read with perf_event_open(2): one read() system call
+//  at each end of every call, so for diagnosis rather than production.
+#ifndef CSPAN_INSTRUMENT
+#define CSPAN_INSTRUMENT 0
+#endif  /* CSPAN_INSTRUMENT */
+
+#ifndef CSPAN_INSTRUMENT_PERF
+#define CSPAN_INSTRUMENT_PERF 0
+#endif  /* CSPAN_INSTRUMENT_PERF */
+
+#if (CSPAN_INSTRUMENT_PERF && !CSPAN_INSTRUMENT)
+#error "CSPAN_INSTRUMENT_PERF needs CSPAN_INSTRUMENT"
+#endif  /* (CSPAN_INSTRUMENT_PERF && !CSPAN_INSTRUMENT) */
+
+#if (CSPAN_INSTRUMENT_PERF && !defined(__linux__))
+#error "CSPAN_INSTRUMENT_PERF needs Linux perf_event_open(2)"
+#endif  /* (CSPAN_INSTRUMENT_PERF && !defined(__linux__)) */
+
+#if (CSPAN_INSTRUMENT)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if (CSPAN_INSTRUMENT_PERF)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+
+//  Inside an instrumented algorithm: CSPAN_PROBE(name) first, then
+//  return CSPAN_RESULT(matched, bytes_scanned) (a bool, passed through).
+#define CSPAN_PROBE(algorithm) \
+  ::cspan::instrument::probe cspan_probe_ { ::cspan::instrument::op::algorithm }
+#define CSPAN_RESULT(matched, bytes) cspan_probe_.result((matched), (bytes))
+
+//  MARK: - namespace cspan::instrument
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace instrument {
+
+enum class op : std::size_t {
+  slide,
+  starts_with,
+  ends_with,
+  contains,
+};
+
+inline constexpr std::size_t op_count { 4U };
+
+[[nodiscard]]
+constexpr std::string_view name(op const algorithm) noexcept {
+  constexpr std::string_view names[op_count] { "slide", "starts_with", "ends_with", "contains", };
+  return names[static_cast<std::size_t>(algorithm)];
+}
+
+//  Latency bucket b counts calls of [2^(b-1), 2^b) ns; bucket 0 is 0 ns.
+inline constexpr std::size_t latency_buckets { 32U };
+
+/*
+ *  MARK: stats
+ *  One algorithm's counters, merged over all threads. A match / miss is
+ *  a true / false result (for slide: a window in range / one clamped to
+ *  empty). cycles and cache_misses are summed over the perf_calls calls
+ *  that could read them: none without CSPAN_INSTRUMENT_PERF or where the
+ *  kernel refuses the counters.
+ */
+struct stats {
+  std::uint64_t calls { 0U };
+  std::uint64_t bytes { 0U };
+  std::uint64_t matches { 0U };
+  std::uint64_t misses { 0U };
+  std::uint64_t cycles { 0U };
+  std::uint64_t cache_misses { 0U };
+  std::uint64_t perf_calls { 0U };
+  std::array<std::uint64_t, latency_buckets> latency {};
+
+  [[nodiscard]]
+  double match_ratio() const noexcept {
+    auto const decided = matches + misses;
+    return decided == 0U ? 0.0 : static_cast<double>(matches) / static_cast<double>(decided);
+  }
+
+  //  Upper bound in ns of the bucket holding the `quantile` (0 .. 1) call:
+  //  2^b for bucket b, 0 for bucket 0.
+  [[nodiscard]]
+  std::uint64_t latency_quantile(double const quantile) const noexcept {
+    if (calls == 0U) {
+      return 0U;
+    }
+    auto const rank = static_cast<std::uint64_t>(quantile * static_cast<double>(calls - 1U));
+    std::uint64_t seen { 0U };
+    for (std::size_t bucket { 0U }; bucket != latency_buckets; ++bucket) {
+      seen += latency[bucket];
+      if (seen > rank) {
+        return bucket == 0U ? 0U : std::uint64_t { 1U } << bucket;
+      }
+    }
+    return 0U;
+  }
+};
+
+namespace detail {
+
+//  Written only by the owning thread, so a relaxed load + store is enough;
+//  atomic so that readers on other threads see whole values.
+inline void bump(std::atomic<std::uint64_t> & counter, std::uint64_t const by) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+struct op_counters {
+  std::atomic<std::uint64_t> calls { 0U };
+  std::atomic<std::uint64_t> bytes { 0U };
+  std::atomic<std::uint64_t> matches { 0U };
+  std::atomic<std::uint64_t> misses { 0U };
+  std::atomic<std::uint64_t> cycles { 0U };
+  std::atomic<std::uint64_t> cache_misses { 0U };
+  std::atomic<std::uint64_t> perf_calls { 0U };
+  std::array<std::atomic<std::uint64_t>, latency_buckets> latency {};
+
+  void add_to(stats & total) const noexcept {
+    total.calls += calls.load(std::memory_order_relaxed);
+    total.bytes += bytes.load(std::memory_order_relaxed);
+    total.matches += matches.load(std::memory_order_relaxed);
+    total.misses += misses.load(std::memory_order_relaxed);
+    total.cycles += cycles.load(std::memory_order_relaxed);
+    total.cache_misses += cache_misses.load(std::memory_order_relaxed);
+    total.perf_calls += perf_calls.load(std::memory_order_relaxed);
+    for (std::size_t bucket { 0U }; bucket != latency_buckets; ++bucket) {
+      total.latency[bucket] += latency[bucket].load(std::memory_order_relaxed);
+    }
+  }
+
+  void clear() noexcept {
+    for (auto * const counter : { &calls, &bytes, &matches, &misses, &cycles, &cache_misses, &perf_calls, }) {
+      counter->store(0U, std::memory_order_relaxed);
+    }
+    for (auto & bucket : latency) {
+      bucket.store(0U, std::memory_order_relaxed);
+    }
+  }
+};
+
+#if (CSPAN_INSTRUMENT_PERF)
+/*
+ *  MARK: perf_group
+ *  CPU cycles and cache misses of the calling thread, user space only,
+ *  read together as one perf event group.
+ */
+class perf_group {
+public:
+  perf_group() noexcept {
+    leader_ = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_ >= 0) {
+      misses_ = open(PERF_COUNT_HW_CACHE_MISSES, leader_);
+    }
+  }
+
+  perf_group(perf_group const &) = delete;
+  perf_group & operator=(perf_group const &) = delete;
+
+  ~perf_group() {
+    for (auto const fd : { misses_, leader_, }) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+
+  //  { cycles, cache misses } so far; false if the counters are unavailable.
+  bool read(std::array<std::uint64_t, 2U> & values) const noexcept {
+    struct {
+      std::uint64_t count;
+      std::uint64_t value[2U];
+    } group {};
+    if (leader_ < 0 || ::read(leader_, &group, sizeof(group)) < static_cast<ssize_t>(2U * sizeof(std::uint64_t))) {
+      return false;
+    }
+    values = { group.value[0U], group.count > 1U ? group.value[1U] : 0U };
+    return true;
+  }
+
+private:
+  static int open(std::uint64_t const config, int const group) noexcept {
+    perf_event_attr attr {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1U;
+    attr.exclude_hv = 1U;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0UL));
+  }
+
+  int leader_ { -1 };
+  int misses_ { -1 };
+};
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+
+struct thread_counters;
+
+struct registry {
+  std::mutex lock;
+  std::vector<thread_counters *> live;
+  std::array<stats, op_count> retired {};
+};
+
+[[nodiscard]]
+inline registry & the_registry() {
+  static registry all;
+  return all;
+}
+
+/*
+ *  MARK: thread_counters
+ *  One per thread, on its own cache lines. Registered on the thread's
+ *  first instrumented call; on thread exit its counts move to `retired`.
+ */
+struct alignas(64) thread_counters {
+  thread_counters() {
+    auto & all = the_registry();
+    std::lock_guard const hold { all.lock };
+    all.live.push_back(this);
+  }
+
+  thread_counters(thread_counters const &) = delete;
+  thread_counters & operator=(thread_counters const &) = delete;
+
+  ~thread_counters() {
+    auto & all = the_registry();
+    std::lock_guard const hold { all.lock };
+    for (std::size_t ix { 0U }; ix != op_count; ++ix) {
+      ops[ix].add_to(all.retired[ix]);
+    }
+    all.live.erase(std::find(all.live.begin(), all.live.end(), this));
+  }
+
+  std::array<op_counters, op_count> ops {};
+#if (CSPAN_INSTRUMENT_PERF)
+  perf_group perf {};
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+};
+
+[[nodiscard]]
+inline thread_counters & local_counters() {
+  thread_local thread_counters counters;
+  return counters;
+}
+
+[[nodiscard]]
+inline std::uint64_t now_ns() noexcept {
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} /* namespace detail */
+
+/*
+ *  MARK: probe
+ *  Times one call from construction to destruction and counts it against
+ *  its algorithm on this thread. Does nothing during constant evaluation,
+ *  so it can sit in constexpr algorithms.
+ */
+class probe {
+public:
+  constexpr explicit probe(op const algorithm) noexcept
+    : algorithm_ { algorithm } {
+    if (!std::is_constant_evaluated()) {
+      begin();
+    }
+  }
+
+  probe(probe const &) = delete;
+  probe & operator=(probe const &) = delete;
+
+  constexpr ~probe() {
+    if (!std::is_constant_evaluated()) {
+      end();
+    }
+  }
+
+  //  Record the call's outcome; returns `matched`.
+  constexpr bool result(bool const matched, std::size_t const bytes) noexcept {
+    outcome_ = matched ? outcome::match : outcome::miss;
+    bytes_ = bytes;
+    return matched;
+  }
+
+private:
+  enum class outcome { none, match, miss, };
+
+  void begin() noexcept {
+    counters_ = &detail::local_counters();
+#if (CSPAN_INSTRUMENT_PERF)
+    perf_ok_ = counters_->perf.read(perf_);
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+    start_ = detail::now_ns();
+  }
+
+  void end() noexcept {
+    auto const elapsed = detail::now_ns() - start_;
+    auto & counters = counters_->ops[static_cast<std::size_t>(algorithm_)];
+    detail::bump(counters.calls, 1U);
+    detail::bump(counters.bytes, bytes_);
+    if (outcome_ != outcome::none) {
+      detail::bump(outcome_ == outcome::match ? counters.matches : counters.misses, 1U);
+    }
+    auto const bucket = std::min<std::size_t>(std::bit_width(elapsed), latency_buckets - 1U);
+    detail::bump(counters.latency[bucket], 1U);
+#if (CSPAN_INSTRUMENT_PERF)
+    std::array<std::uint64_t, 2U> now {};
+    if (perf_ok_ && counters_->perf.read(now)) {
+      detail::bump(counters.cycles, now[0U] - perf_[0U]);
+      detail::bump(counters.cache_misses, now[1U] - perf_[1U]);
+      detail::bump(counters.perf_calls, 1U);
+    }
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+  }
+
+  op algorithm_;
+  outcome outcome_ { outcome::none };
+  std::size_t bytes_ { 0U };
+  std::uint64_t start_ { 0U };
+  detail::thread_counters * counters_ { nullptr };
+#if (CSPAN_INSTRUMENT_PERF)
+  std::array<std::uint64_t, 2U> perf_ {};
+  bool perf_ok_ { false };
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+};
+
+//  MARK: snapshot(), reset()
+//  Every thread's counters, live and exited, merged. Counts from calls
+//  still in progress on other threads may or may not be included.
+[[nodiscard]]
+inline std::array<stats, op_count> snapshot() {
+  auto & all = detail::the_registry();
+  std::lock_guard const hold { all.lock };
+  auto merged = all.retired;
+  for (auto const * const counters : all.live) {
+    for (std::size_t ix { 0U }; ix != op_count; ++ix) {
+      counters->ops[ix].add_to(merged[ix]);
+    }
+  }
+  return merged;
+}
+
+[[nodiscard]]
+inline stats snapshot(op const algorithm) {
+  return snapshot()[static_cast<std::size_t>(algorithm)];
+}
+
+//  Zero every counter. Exact when no other thread is mid-call; otherwise
+//  a concurrent update may survive or be lost.
+inline void reset() {
+  auto & all = detail::the_registry();
+  std::lock_guard const hold { all.lock };
+  all.retired = {};
+  for (auto * const counters : all.live) {
+    for (auto & counter : counters->ops) {
+      counter.clear();
+    }
+  }
+}
+
+/*
+ *  MARK: dump()
+ *  One line per algorithm that has been called: calls, bytes scanned,
+ *  matches / misses, latency p50 / p99 (bucket upper bounds) and, with
+ *  perf counters, mean cycles and cache misses per call ("-" where the
+ *  counters could not be read).
+ */
+inline std::ostream & dump(std::ostream & out) {
+  auto const all = snapshot();
+  auto const flags = out.flags();
+  auto const precision = out.precision();
+  out << "algorithm        calls        bytes   matches    misses   p50 ns   p99 ns"
+#if (CSPAN_INSTRUMENT_PERF)
+         "  cycles/call  misses/call"
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+         "\n";
+  for (std::size_t ix { 0U }; ix != op_count; ++ix) {
+    auto const & row = all[ix];
+    if (row.calls == 0U) {
+      continue;
+    }
+    out << std::left << std::setw(12) << name(static_cast<op>(ix)) << std::right
+        << std::setw(10) << row.calls
+        << std::setw(13) << row.bytes
+        << std::setw(10) << row.matches
+        << std::setw(10) << row.misses
+        << std::setw(9) << row.latency_quantile(0.5)
+        << std::setw(9) << row.latency_quantile(0.99);
+#if (CSPAN_INSTRUMENT_PERF)
+    if (row.perf_calls == 0U) {
+      out << std::setw(13) << '-' << std::setw(13) << '-';
+    }
+    else {
+      auto const calls = static_cast<double>(row.perf_calls);
+      out << std::fixed << std::setprecision(1)
+          << std::setw(13) << static_cast<double>(row.cycles) / calls
+          << std::setw(13) << static_cast<double>(row.cache_misses) / calls;
+    }
+#endif  /* (CSPAN_INSTRUMENT_PERF) */
+    out << '\n';
+  }
+  out.flags(flags);
+  out.precision(precision);
+  return out;
+}
+
+} /* namespace instrument */
+} /* namespace cspan */
+
+#else
+
+#define CSPAN_PROBE(algorithm) static_cast<void>(0)
+#define CSPAN_RESULT(matched, bytes) (matched)
+
+#endif  /* (CSPAN_INSTRUMENT) */
+
+#endif /* cspan_instrument_hpp */
@@ -0,0 +1,259 @@
+//
+//  cspan_mapped.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://man7.org/linux/man-pages/man2/mmap.2.html
+//  @see: https://man7.org/linux/man-pages/man2/madvise.2.html
+//
+
+#ifndef cspan_mapped_hpp
+#define cspan_mapped_hpp
+
+#if (__has_include(<sys/mman.h>) && __has_include(<unistd.h>))
+#define CSPAN_HAS_MMAP 1
+#else
+#define CSPAN_HAS_MMAP 0
+#endif  /* (__has_include(<sys/mman.h>) && __has_include(<unistd.h>)) */
+
+#if (CSPAN_HAS_MMAP)
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+//  read_only and read_write share the page cache with the file (writes
+//  reach it); copy_on_write maps private pages, so writes stay in memory.
+enum class map_mode {
+  read_only,
+  copy_on_write,
+  read_write,
+};
+
+//  Access-pattern hint passed to madvise().
+enum class map_advice {
+  normal,
+  sequential,
+  random,
+  will_need,
+};
+
+struct map_options {
+  map_mode mode { map_mode::read_only };
+  map_advice advice { map_advice::normal };
+  //  Ask for transparent huge pages (MADV_HUGEPAGE) where the platform has
+  //  them; a hint, silently ignored elsewhere.
+  bool huge_pages { false };
+  //  Fault the whole file in up front (MAP_POPULATE, Linux).
+  bool populate { false };
+};
+
+/*
+ *  MARK: mapped_file
+ *  RAII owner of one mmap() of a whole file. Move-only; errors throw
+ *  std::system_error. An empty file maps to an empty span.
+ */
+class mapped_file {
+public:
+  mapped_file() noexcept = default;
+
+  explicit mapped_file(std::filesystem::path const & path, map_options const & options = {})
+    : mode_ { options.mode } {
+    auto const writable = options.mode == map_mode::read_write;
+    auto const fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error { errno, std::generic_category(), "open " + path.string() };
+    }
+    struct ::stat info;
+    if (::fstat(fd, &info) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error { error, std::generic_category(), "fstat " + path.string() };
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ != 0U) {
+      auto const prot = options.mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      auto flags = options.mode == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+#if defined(MAP_POPULATE)
+      flags |= options.populate ? MAP_POPULATE : 0;
+#endif  /* defined(MAP_POPULATE) */
+      auto const addr = ::mmap(nullptr, size_, prot, flags, fd, 0);
+      if (addr == MAP_FAILED) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error { error, std::generic_category(), "mmap " + path.string() };
+      }
+      data_ = static_cast<std::byte *>(addr);
+    }
+    ::close(fd);
+
+    advise(options.advice);
+#if defined(MADV_HUGEPAGE)
+    if (options.huge_pages && data_ != nullptr) {
+      ::madvise(data_, size_, MADV_HUGEPAGE);
+    }
+#endif  /* defined(MADV_HUGEPAGE) */
+  }
+
+  mapped_file(mapped_file && other) noexcept
+    : data_ { std::exchange(other.data_, nullptr) },
+      size_ { std::exchange(other.size_, 0U) },
+      mode_ { other.mode_ } {}
+
+  mapped_file & operator=(mapped_file && other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0U);
+      mode_ = other.mode_;
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return size_ == 0U; }
+
+  [[nodiscard]]
+  map_mode mode() const noexcept { return mode_; }
+
+  [[nodiscard]]
+  std::span<std::byte const> bytes() const noexcept { return { data_, size_ }; }
+
+  //  Throws std::system_error (permission_denied) on a read_only mapping,
+  //  whose pages would fault on the first write.
+  [[nodiscard]]
+  std::span<std::byte> writable_bytes() {
+    if (mode_ == map_mode::read_only) {
+      throw std::system_error { std::make_error_code(std::errc::permission_denied),
+                                "mapped_file: read_only mapping is not writable" };
+    }
+    return { data_, size_ };
+  }
+
+  //  Re-advise [offset, offset + length); offsets are rounded out to pages.
+  void advise(map_advice const advice, std::size_t offset = 0U,
+              std::size_t length = std::dynamic_extent) const noexcept {
+    if (data_ == nullptr || offset >= size_) {
+      return;
+    }
+    length = std::min(length, size_ - offset);
+    auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const first = offset / page * page;
+    ::madvise(data_ + first, length + (offset - first), native(advice));
+  }
+
+  //  Write dirty pages of a read_write mapping back to the file.
+  void sync() const {
+    if (data_ != nullptr && mode_ == map_mode::read_write
+        && ::msync(data_, size_, MS_SYNC) != 0) {
+      throw std::system_error { errno, std::generic_category(), "msync" };
+    }
+  }
+
+private:
+  static int native(map_advice const advice) noexcept {
+    switch (advice) {
+      case map_advice::sequential: return MADV_SEQUENTIAL;
+      case map_advice::random:     return MADV_RANDOM;
+      case map_advice::will_need:  return MADV_WILLNEED;
+      default:                     return MADV_NORMAL;
+    }
+  }
+
+  void unmap() noexcept {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+      size_ = 0U;
+    }
+  }
+
+  std::byte * data_ { nullptr };
+  std::size_t size_ { 0U };
+  map_mode mode_ { map_mode::read_only };
+};
+
+/*
+ *  MARK: mapped_span
+ *  A mapped_file viewed as an array of T from byte `offset` on. The
+ *  offset must be aligned for T and the remaining size a whole number of
+ *  T; otherwise construction throws std::system_error (invalid_argument).
+ */
+template<class T>
+class mapped_span {
+  static_assert(std::is_trivially_copyable_v<T> && !std::is_const_v<T>,
+                "mapped_span needs a non-const, trivially copyable T");
+
+public:
+  explicit mapped_span(std::filesystem::path const & path, map_options const & options = {},
+                       std::size_t const offset = 0U)
+    : mapped_span(mapped_file { path, options }, offset) {}
+
+  explicit mapped_span(mapped_file file, std::size_t const offset = 0U)
+    : file_ { std::move(file) } {
+    if (offset > file_.size()) {
+      throw std::system_error { std::make_error_code(std::errc::invalid_argument),
+                                "mapped_span: offset past end of file" };
+    }
+    auto const base = file_.bytes().data() + offset;
+    auto const bytes = file_.size() - offset;
+    if (reinterpret_cast<std::uintptr_t>(base) % alignof(T) != 0U) {
+      throw std::system_error { std::make_error_code(std::errc::invalid_argument),
+                                "mapped_span: offset misaligned for T" };
+    }
+    if (bytes % sizeof(T) != 0U) {
+      throw std::system_error { std::make_error_code(std::errc::invalid_argument),
+                                "mapped_span: size not a multiple of sizeof(T)" };
+    }
+    offset_ = offset;
+    count_ = bytes / sizeof(T);
+  }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return count_; }
+
+  [[nodiscard]]
+  std::span<T const> span() const noexcept {
+    return { reinterpret_cast<T const *>(file_.bytes().data() + offset_), count_ };
+  }
+
+  //  Throws like mapped_file::writable_bytes() on a read_only mapping.
+  [[nodiscard]]
+  std::span<T> writable_span() {
+    return { reinterpret_cast<T *>(file_.writable_bytes().data() + offset_), count_ };
+  }
+
+  [[nodiscard]]
+  mapped_file const & file() const noexcept { return file_; }
+
+private:
+  mapped_file file_;
+  std::size_t offset_ { 0U };
+  std::size_t count_ { 0U };
+};
+
+} /* namespace cspan */
+
+#endif  /* (CSPAN_HAS_MMAP) */
+
+#endif /* cspan_mapped_hpp */
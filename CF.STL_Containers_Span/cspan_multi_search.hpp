@@ -0,0 +1,355 @@
+//
+//  cspan_multi_search.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Aho%E2%80%93Corasick_algorithm
+//
+
+#ifndef cspan_multi_search_hpp
+#define cspan_multi_search_hpp
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cspan_config.hpp"
+#include "cspan_search.hpp"
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: multi_searcher
+ *  Aho-Corasick automaton over a set of patterns, matched in a single pass.
+ *
+ *  All state lives in flat arrays indexed by state number (breadth-first
+ *  order, so the shallow, hot states share cache lines):
+ *    - edges in CSR form: edge_first_[s] .. edge_first_[s + 1] index sorted
+ *      edge_key_ / edge_next_;
+ *    - fail_ / dict_ links and the CSR list of pattern ids ending in a state;
+ *    - for byte-sized T the root's transitions are a dense 256-entry table
+ *      and, when states x byte classes stays under dfa_budget, a complete
+ *      DFA table (rows padded to a power of two) replaces the failure walk.
+ *  Patterns are copied into the automaton and need not outlive it.
+ *  Empty patterns never match.
+ */
+template<class T>
+class multi_searcher {
+public:
+  using value_type = std::remove_cv_t<T>;
+  using state_type = std::uint32_t;
+
+  static_assert(detail::is_bitwise_comparable_v<value_type>,
+                "multi_searcher needs totally ordered, bitwise comparable elements");
+
+  struct match {
+    std::size_t pattern;  //  index into the pattern set
+    std::size_t offset;   //  start of the occurrence in the haystack
+  };
+
+  explicit multi_searcher(std::span<std::span<T const> const> patterns) {
+    build(patterns);
+  }
+
+  multi_searcher(std::initializer_list<std::span<T const>> patterns) {
+    build(std::span<std::span<T const> const> { patterns.begin(), patterns.size() });
+  }
+
+  [[nodiscard]]
+  std::size_t patterns() const noexcept { return length_.size(); }
+
+  [[nodiscard]]
+  std::size_t states() const noexcept { return fail_.size(); }
+
+  //  Call `on_match(match)` for every occurrence of every pattern, in order
+  //  of the occurrence's end position. Stops early if on_match returns false.
+  template<class Fn>
+  void for_each_match(std::span<T const> hay, Fn && on_match) const {
+    if constexpr (dense_root) {
+      if (!delta_.empty()) {
+        //  `row` is the premultiplied state: one add and one load per byte.
+        run(hay, on_match, [this](state_type const row, value_type const value) {
+          return delta_[row | class_of_[static_cast<std::uint8_t>(detail::key(value))]];
+        }, [this](state_type const row) {
+          return static_cast<state_type>(row >> shift_);
+        });
+        return;
+      }
+    }
+    run(hay, on_match, [this](state_type const state, value_type const value) {
+      return step(state, value);
+    }, [](state_type const state) {
+      return state;
+    });
+  }
+
+  //  Write matches into `out` until it is full, without allocating.
+  //  Returns the filled prefix of `out`.
+  [[nodiscard]]
+  std::span<match> find_all(std::span<T const> hay, std::span<match> out) const {
+    std::size_t filled { 0U };
+    if (!out.empty()) {
+      for_each_match(hay, [&](match const & found) {
+        out[filled++] = found;
+        return filled != out.size();
+      });
+    }
+    return out.first(filled);
+  }
+
+  [[nodiscard]]
+  std::size_t count(std::span<T const> hay) const {
+    std::size_t matches { 0U };
+    for_each_match(hay, [&matches](match const &) {
+      ++matches;
+      return true;
+    });
+    return matches;
+  }
+
+  [[nodiscard]]
+  bool contains_any(std::span<T const> hay) const {
+    auto found { false };
+    for_each_match(hay, [&found](match const &) {
+      found = true;
+      return false;
+    });
+    return found;
+  }
+
+private:
+  static bool constexpr dense_root { sizeof(value_type) == 1U };
+
+  //  Largest full transition table (states x byte classes) worth building.
+  static std::size_t constexpr dfa_budget { 1U << 21U };
+
+  template<class Fn, class Next, class Id>
+  void run(std::span<T const> hay, Fn && on_match, Next next, Id id_of) const {
+    state_type state { 0U };
+    for (std::size_t pos { 0U }; pos != hay.size(); ++pos) {
+      state = next(state, hay[pos]);
+      for (auto out { report_[id_of(state)] }; out != 0U; out = dict_[out]) {
+        for (auto ix { out_first_[out] }; ix != out_first_[out + 1U]; ++ix) {
+          auto const id = out_id_[ix];
+          if (!on_match(match { id, pos + 1U - length_[id] })) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  [[nodiscard]]
+  bool has_output(state_type const state) const noexcept {
+    return out_first_[state] != out_first_[state + 1U];
+  }
+
+  //  Transition out of `state` on `value`, no_edge if there is none.
+  [[nodiscard]]
+  state_type edge(state_type const state, value_type const value) const {
+    auto const first = edge_key_.begin() + edge_first_[state];
+    auto const last  = edge_key_.begin() + edge_first_[state + 1U];
+    auto const kv = detail::key(value);
+    auto it { first };
+    if (last - first <= 8) {
+      while (it != last && detail::key(*it) < kv) {
+        ++it;
+      }
+    }
+    else {
+      it = std::lower_bound(first, last, value,
+                            [](value_type const lhs, value_type const rhs) {
+        return detail::key(lhs) < detail::key(rhs);
+      });
+    }
+    return (it != last && *it == value)
+      ? edge_next_[static_cast<std::size_t>(it - edge_key_.begin())]
+      : no_edge;
+  }
+
+  [[nodiscard]]
+  state_type step(state_type state, value_type const value) const {
+    for (;;) {
+      if (state == 0U) {
+        if constexpr (dense_root) {
+          return root_[static_cast<std::uint8_t>(detail::key(value))];
+        }
+        else {
+          auto const next = edge(0U, value);
+          return next == no_edge ? 0U : next;
+        }
+      }
+      if (auto const next = edge(state, value); next != no_edge) {
+        return next;
+      }
+      state = fail_[state];
+    }
+  }
+
+  void build(std::span<std::span<T const> const> patterns) {
+    //  1. Plain trie with per-node child lists.
+    struct node {
+      std::vector<std::pair<value_type, state_type>> child;
+      std::vector<std::size_t> ids;
+    };
+    std::vector<node> trie(1U);
+    length_.reserve(patterns.size());
+    for (std::size_t id { 0U }; id != patterns.size(); ++id) {
+      auto const pattern = patterns[id];
+      length_.push_back(pattern.size());
+      if (pattern.empty()) {
+        continue;
+      }
+      state_type cur { 0U };
+      for (auto const value : pattern) {
+        auto & kids = trie[cur].child;
+        auto it = std::find_if(kids.begin(), kids.end(), [value](auto const & kid) {
+          return kid.first == value;
+        });
+        if (it == kids.end()) {
+          kids.emplace_back(value, static_cast<state_type>(trie.size()));
+          cur = static_cast<state_type>(trie.size());
+          trie.emplace_back();
+        }
+        else {
+          cur = it->second;
+        }
+      }
+      trie[cur].ids.push_back(id);
+    }
+
+    //  2. Renumber breadth-first and lay the trie out in CSR form.
+    auto const count = trie.size();
+    std::vector<state_type> order;
+    std::vector<state_type> renum(count);
+    order.reserve(count);
+    order.push_back(0U);
+    for (std::size_t head { 0U }; head != order.size(); ++head) {
+      auto & kids = trie[order[head]].child;
+      std::sort(kids.begin(), kids.end(), [](auto const & lhs, auto const & rhs) {
+        return detail::key(lhs.first) < detail::key(rhs.first);
+      });
+      for (auto const & kid : kids) {
+        renum[kid.second] = static_cast<state_type>(order.size());
+        order.push_back(kid.second);
+      }
+    }
+
+    edge_first_.assign(count + 1U, 0U);
+    out_first_.assign(count + 1U, 0U);
+    edge_key_.clear();
+    edge_next_.clear();
+    out_id_.clear();
+    for (std::size_t st { 0U }; st != count; ++st) {
+      auto const & old = trie[order[st]];
+      edge_first_[st] = static_cast<state_type>(edge_key_.size());
+      for (auto const & kid : old.child) {
+        edge_key_.push_back(kid.first);
+        edge_next_.push_back(renum[kid.second]);
+      }
+      out_first_[st] = static_cast<state_type>(out_id_.size());
+      out_id_.insert(out_id_.end(), old.ids.begin(), old.ids.end());
+    }
+    edge_first_[count] = static_cast<state_type>(edge_key_.size());
+    out_first_[count] = static_cast<state_type>(out_id_.size());
+
+    //  3. Failure and dictionary-suffix links, breadth-first.
+    fail_.assign(count, 0U);
+    dict_.assign(count, 0U);
+    if constexpr (dense_root) {
+      root_.fill(0U);
+      for (auto ix { edge_first_[0] }; ix != edge_first_[1]; ++ix) {
+        root_[static_cast<std::uint8_t>(detail::key(edge_key_[ix]))] = edge_next_[ix];
+      }
+    }
+    for (std::size_t st { 0U }; st != count; ++st) {
+      for (auto ix { edge_first_[st] }; ix != edge_first_[st + 1U]; ++ix) {
+        auto const next = edge_next_[ix];
+        fail_[next] = st == 0U
+          ? 0U
+          : step(fail_[st], edge_key_[ix]);
+        auto const fl = fail_[next];
+        dict_[next] = has_output(fl) ? fl : dict_[fl];
+      }
+    }
+    report_.resize(count);
+    for (std::size_t st { 0U }; st != count; ++st) {
+      report_[st] = has_output(static_cast<state_type>(st))
+        ? static_cast<state_type>(st)
+        : dict_[st];
+    }
+
+    //  4. Byte elements: a full DFA over the byte classes that occur in
+    //     the patterns, if it fits the budget; no failure chasing at all.
+    if constexpr (dense_root) {
+      //  Bytes that occur in some pattern get a class each; all others
+      //  share one, unless every byte value occurs.
+      std::array<bool, 256U> present {};
+      for (auto const value : edge_key_) {
+        present[static_cast<std::uint8_t>(detail::key(value))] = true;
+      }
+      std::size_t classes { 0U };
+      for (std::size_t byte { 0U }; byte != present.size(); ++byte) {
+        if (present[byte]) {
+          class_of_[byte] = static_cast<std::uint16_t>(classes++);
+        }
+      }
+      for (std::size_t byte { 0U }; byte != present.size(); ++byte) {
+        if (!present[byte]) {
+          class_of_[byte] = static_cast<std::uint16_t>(classes);
+        }
+      }
+      classes += classes != present.size() ? 1U : 0U;
+      //  Rows are padded to a power of two so a state is a row offset.
+      shift_ = 0U;
+      while ((std::size_t { 1U } << shift_) < classes) {
+        ++shift_;
+      }
+      auto const width = std::size_t { 1U } << shift_;
+      delta_.clear();
+      if (count * width <= dfa_budget) {
+        delta_.assign(count * width, 0U);
+        for (std::size_t st { 0U }; st != count; ++st) {
+          auto const row = delta_.begin() + static_cast<std::ptrdiff_t>(st * width);
+          if (st != 0U) {
+            auto const fail_row = delta_.begin() + static_cast<std::ptrdiff_t>(fail_[st] * width);
+            std::copy(fail_row, fail_row + static_cast<std::ptrdiff_t>(width), row);
+          }
+          for (auto ix { edge_first_[st] }; ix != edge_first_[st + 1U]; ++ix) {
+            row[class_of_[static_cast<std::uint8_t>(detail::key(edge_key_[ix]))]]
+              = static_cast<state_type>(edge_next_[ix] << shift_);
+          }
+        }
+      }
+    }
+  }
+
+  static state_type constexpr no_edge { std::numeric_limits<state_type>::max() };
+
+  std::vector<std::size_t> length_;
+  std::vector<state_type> edge_first_;
+  std::vector<value_type> edge_key_;
+  std::vector<state_type> edge_next_;
+  std::vector<state_type> fail_;
+  std::vector<state_type> dict_;
+  std::vector<state_type> out_first_;
+  std::vector<std::size_t> out_id_;
+  std::vector<state_type> report_;
+  std::array<state_type, dense_root ? 256U : 1U> root_ {};
+  std::array<std::uint16_t, dense_root ? 256U : 1U> class_of_ {};
+  unsigned shift_ { 0U };
+  std::vector<state_type> delta_;
+};
+
+} /* namespace cspan */
+
+#endif /* cspan_multi_search_hpp */
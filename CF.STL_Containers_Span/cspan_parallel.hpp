@@ -0,0 +1,436 @@
+//
+//  cspan_parallel.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Work_stealing
+//  @see: https://en.cppreference.com/w/cpp/thread/hardware_destructive_interference_size
+//
+
+#ifndef cspan_parallel_hpp
+#define cspan_parallel_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "cspan_search.hpp"
+
+//  MARK: - namespace cspan::par
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace par {
+
+/*
+ *  MARK: thread_pool
+ *  Fork-join pool: run(tasks, fn) calls fn(ix) for every ix in [0, tasks)
+ *  on the pool's workers plus the calling thread, and returns when all
+ *  are done. Each participant starts with a contiguous block of task
+ *  indices, takes from its front, and when empty steals the back half of
+ *  another participant's block. The first exception thrown by a task is
+ *  rethrown from run(); remaining tasks still run.
+ *  Calls from other threads take turns. A run() (or par:: algorithm) made
+ *  from inside one of the pool's own tasks runs its tasks inline on the
+ *  calling thread, since the workers it would wait for may be busy with
+ *  the enclosing run().
+ */
+class thread_pool {
+public:
+  //  `threads` participants in total, the caller included.
+  explicit thread_pool(std::size_t const threads = std::max(1U, std::thread::hardware_concurrency()))
+    : slots_(std::max<std::size_t>(threads, 1U)) {
+    for (std::size_t ix { 1U }; ix < slots_.size(); ++ix) {
+      workers_.emplace_back([this, ix] { work(ix); });
+    }
+  }
+
+  thread_pool(thread_pool const &) = delete;
+  thread_pool & operator=(thread_pool const &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard lock { mutex_ };
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return slots_.size(); }
+
+  template<class Fn>
+  void run(std::size_t const tasks, Fn && fn) {
+    if (tasks == 0U) {
+      return;
+    }
+    if (slots_.size() == 1U || tasks == 1U || running_here()) {
+      for (std::size_t ix { 0U }; ix != tasks; ++ix) {
+        fn(ix);
+      }
+      return;
+    }
+
+    std::lock_guard serial { run_mutex_ };
+    auto const parts = slots_.size();
+    for (std::size_t ix { 0U }; ix != parts; ++ix) {
+      std::lock_guard lock { slots_[ix].mutex };
+      slots_[ix].first = tasks * ix / parts;
+      slots_[ix].last = tasks * (ix + 1U) / parts;
+    }
+    {
+      std::lock_guard lock { mutex_ };
+      task_ = [](void * const context, std::size_t const ix) {
+        (*static_cast<std::remove_reference_t<Fn> *>(context))(ix);
+      };
+      context_ = std::addressof(fn);
+      error_ = nullptr;
+      active_ = workers_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    drain(0U);
+
+    std::unique_lock lock { mutex_ };
+    idle_.wait(lock, [this] { return active_ == 0U; });
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+private:
+  struct alignas(64) slot {
+    std::mutex mutex;
+    std::size_t first { 0U };
+    std::size_t last { 0U };
+  };
+
+  //  The pools whose tasks this thread is running, innermost first.
+  struct frame {
+    thread_pool const * pool;
+    frame const * outer;
+  };
+
+  [[nodiscard]]
+  static frame const *& frames() noexcept {
+    thread_local frame const * innermost { nullptr };
+    return innermost;
+  }
+
+  [[nodiscard]]
+  bool running_here() const noexcept {
+    for (auto at = frames(); at != nullptr; at = at->outer) {
+      if (at->pool == this) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //  Next task for participant `self`: the front of its own block, else
+  //  the back half (rounded up) of the next non-empty block. False once
+  //  every block is empty.
+  bool take(std::size_t const self, std::size_t & task) {
+    {
+      std::lock_guard lock { slots_[self].mutex };
+      if (slots_[self].first != slots_[self].last) {
+        task = slots_[self].first++;
+        return true;
+      }
+    }
+    for (std::size_t step { 1U }; step != slots_.size(); ++step) {
+      auto & victim = slots_[(self + step) % slots_.size()];
+      std::size_t first;
+      std::size_t last;
+      {
+        std::lock_guard lock { victim.mutex };
+        if (victim.first == victim.last) {
+          continue;
+        }
+        last = victim.last;
+        first = last - (last - victim.first + 1U) / 2U;
+        victim.last = first;
+      }
+      std::lock_guard lock { slots_[self].mutex };
+      task = first;
+      slots_[self].first = first + 1U;
+      slots_[self].last = last;
+      return true;
+    }
+    return false;
+  }
+
+  void drain(std::size_t const self) {
+    frame const here { this, frames() };
+    frames() = &here;
+    std::size_t task;
+    while (take(self, task)) {
+      try {
+        task_(context_, task);
+      }
+      catch (...) {
+        std::lock_guard lock { mutex_ };
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+    }
+    frames() = here.outer;
+  }
+
+  void work(std::size_t const self) {
+    std::size_t seen { 0U };
+    std::unique_lock lock { mutex_ };
+    for (;;) {
+      wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      lock.unlock();
+      drain(self);
+      lock.lock();
+      if (--active_ == 0U) {
+        idle_.notify_all();
+      }
+    }
+  }
+
+  std::vector<slot> slots_;
+  std::vector<std::thread> workers_;
+
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  void (*task_)(void *, std::size_t) { nullptr };
+  void * context_ { nullptr };
+  std::exception_ptr error_;
+  std::size_t active_ { 0U };
+  std::size_t generation_ { 0U };
+  bool stop_ { false };
+};
+
+//  MARK: default_pool()
+//  One participant per hardware thread; created on first use.
+[[nodiscard]]
+inline thread_pool & default_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+//  MARK: - namespace cspan::par::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace detail {
+
+//  Partitions of at least this many bytes; more partitions than
+//  participants so that stealing can even out the load.
+inline constexpr std::size_t grain_bytes { 256U << 10U };
+inline constexpr std::size_t parts_per_thread { 8U };
+inline constexpr std::size_t cache_line { 64U };
+
+/*
+ *  MARK: partition
+ *  Splits `count` elements at `data` into parts() pieces whose interior
+ *  boundaries fall on cache-line addresses (when sizeof(T) divides a
+ *  line), so no two tasks write the same line.
+ */
+template<class T>
+class partition {
+public:
+  partition(T const * const data, std::size_t const count, std::size_t const threads)
+    : data_ { data }, count_ { count },
+      parts_ { std::clamp<std::size_t>(count * sizeof(T) / grain_bytes, 1U,
+                                       threads * parts_per_thread) } {}
+
+  [[nodiscard]]
+  std::size_t parts() const noexcept { return parts_; }
+
+  //  First element of part `ix`; bound(parts()) == count.
+  [[nodiscard]]
+  std::size_t bound(std::size_t const ix) const noexcept {
+    if (ix == 0U || ix >= parts_) {
+      return ix == 0U ? 0U : count_;
+    }
+    auto const raw = count_ / parts_ * ix + count_ % parts_ * ix / parts_;
+    if constexpr (cache_line % sizeof(T) == 0U) {
+      auto const base = reinterpret_cast<std::uintptr_t>(data_);
+      if (base % sizeof(T) == 0U) {
+        auto const addr = (base + raw * sizeof(T) + cache_line - 1U) / cache_line * cache_line;
+        return std::min(count_, (addr - base) / sizeof(T));
+      }
+    }
+    return raw;
+  }
+
+private:
+  T const * data_;
+  std::size_t count_;
+  std::size_t parts_;
+};
+
+} /* namespace detail */
+
+//  MARK: contains() / count()
+//  Part k searches the match starts in [bound(k), bound(k + 1)), reading
+//  needle.size() - 1 elements past its edge, so straddling matches are
+//  found once. count() counts overlapping matches, as searcher::count.
+template<class T, std::size_t N, class U, std::size_t M>
+[[nodiscard]]
+bool contains(thread_pool & pool, std::span<T, N> const span, std::span<U, M> const sub) {
+  using V = std::remove_cv_t<T>;
+  static_assert(std::is_same_v<V, std::remove_cv_t<U>>, "par::contains: element types differ");
+  std::span<V const> const hay { span };
+  std::span<V const> const needle { sub };
+  if (needle.size() > hay.size()) {
+    return false;
+  }
+  searcher<V> const search { needle };
+  detail::partition<V> const parts { hay.data(), hay.size() - needle.size() + 1U, pool.size() };
+  std::atomic<bool> found { false };
+  pool.run(parts.parts(), [&](std::size_t const ix) {
+    if (found.load(std::memory_order_relaxed)) {
+      return;
+    }
+    auto const first = parts.bound(ix);
+    auto const last = parts.bound(ix + 1U);
+    if (first != last && search.contains(hay.subspan(first, last - first + needle.size() - 1U))) {
+      found.store(true, std::memory_order_relaxed);
+    }
+  });
+  return found.load();
+}
+
+template<class T, std::size_t N, class U, std::size_t M>
+[[nodiscard]]
+std::size_t count(thread_pool & pool, std::span<T, N> const span, std::span<U, M> const sub) {
+  using V = std::remove_cv_t<T>;
+  static_assert(std::is_same_v<V, std::remove_cv_t<U>>, "par::count: element types differ");
+  std::span<V const> const hay { span };
+  std::span<V const> const needle { sub };
+  if (needle.size() > hay.size()) {
+    return 0U;
+  }
+  searcher<V> const search { needle };
+  detail::partition<V> const parts { hay.data(), hay.size() - needle.size() + 1U, pool.size() };
+  std::atomic<std::size_t> total { 0U };
+  pool.run(parts.parts(), [&](std::size_t const ix) {
+    auto const first = parts.bound(ix);
+    auto const last = parts.bound(ix + 1U);
+    if (first != last) {
+      total.fetch_add(search.count(hay.subspan(first, last - first + needle.size() - 1U)),
+                      std::memory_order_relaxed);
+    }
+  });
+  return total.load();
+}
+
+//  MARK: transform()
+//  out[i] = fn(in[i]); parts are cut on cache lines of `out`.
+template<class T, std::size_t N, class U, std::size_t M, class Fn>
+std::span<U> transform(thread_pool & pool, std::span<T, N> const in, std::span<U, M> const out, Fn fn) {
+  assert(out.size() >= in.size());
+  detail::partition<U> const parts { out.data(), in.size(), pool.size() };
+  pool.run(parts.parts(), [&](std::size_t const ix) {
+    auto const first = parts.bound(ix);
+    auto const last = parts.bound(ix + 1U);
+    std::transform(in.begin() + first, in.begin() + last, out.begin() + first, fn);
+  });
+  return std::span<U> { out.data(), in.size() };
+}
+
+//  MARK: reduce()
+//  op must be associative; partial results combine left to right, so a
+//  non-commutative op is still applied in element order. Each part's
+//  result has a cache line to itself (and R = bool is not packed into
+//  std::vector<bool> words), so parts never write a shared line.
+template<class T, std::size_t N, class R, class Op>
+[[nodiscard]]
+R reduce(thread_pool & pool, std::span<T, N> const in, R init, Op op) {
+  struct alignas(detail::cache_line) padded {
+    R value;
+  };
+  detail::partition<T> const parts { in.data(), in.size(), pool.size() };
+  std::vector<padded> partial(parts.parts(), padded { init });
+  pool.run(parts.parts(), [&](std::size_t const ix) {
+    auto const first = parts.bound(ix);
+    auto const last = parts.bound(ix + 1U);
+    if (first != last) {
+      partial[ix].value = std::accumulate(in.begin() + first + 1, in.begin() + last,
+                                          static_cast<R>(in[first]), op);
+    }
+  });
+  for (std::size_t ix { 0U }; ix != partial.size(); ++ix) {
+    if (parts.bound(ix) != parts.bound(ix + 1U)) {
+      init = op(std::move(init), std::move(partial[ix].value));
+    }
+  }
+  return init;
+}
+
+//  MARK: for_each_window()
+//  fn(std::span<T const>) for every `width`-wide window (stride 1), called
+//  concurrently; part k owns the windows starting in its range and reads
+//  width - 1 elements past its edge.
+template<class T, std::size_t N, class Fn>
+void for_each_window(thread_pool & pool, std::span<T, N> const span, std::size_t const width, Fn fn) {
+  assert(width != 0U);
+  std::span<T const> const in { span };
+  if (width > in.size()) {
+    return;
+  }
+  detail::partition<T> const parts { in.data(), in.size() - width + 1U, pool.size() };
+  pool.run(parts.parts(), [&](std::size_t const ix) {
+    for (auto pos = parts.bound(ix), last = parts.bound(ix + 1U); pos < last; ++pos) {
+      fn(in.subspan(pos, width));
+    }
+  });
+}
+
+//  MARK: default-pool overloads
+template<class T, std::size_t N, class U, std::size_t M>
+[[nodiscard]]
+bool contains(std::span<T, N> const span, std::span<U, M> const sub) {
+  return par::contains(default_pool(), span, sub);
+}
+
+template<class T, std::size_t N, class U, std::size_t M>
+[[nodiscard]]
+std::size_t count(std::span<T, N> const span, std::span<U, M> const sub) {
+  return par::count(default_pool(), span, sub);
+}
+
+template<class T, std::size_t N, class U, std::size_t M, class Fn>
+std::span<U> transform(std::span<T, N> const in, std::span<U, M> const out, Fn fn) {
+  return par::transform(default_pool(), in, out, std::move(fn));
+}
+
+template<class T, std::size_t N, class R, class Op>
+[[nodiscard]]
+R reduce(std::span<T, N> const in, R init, Op op) {
+  return par::reduce(default_pool(), in, std::move(init), std::move(op));
+}
+
+template<class T, std::size_t N, class Fn>
+void for_each_window(std::span<T, N> const in, std::size_t const width, Fn fn) {
+  par::for_each_window(default_pool(), in, width, std::move(fn));
+}
+
+} /* namespace par */
+} /* namespace cspan */
+
+#endif /* cspan_parallel_hpp */
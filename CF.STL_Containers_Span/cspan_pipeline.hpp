@@ -0,0 +1,275 @@
+//
+//  cspan_pipeline.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Loop_fusion
+//  @see: https://en.cppreference.com/w/cpp/ranges/transform_view
+//  @see: https://en.cppreference.com/w/cpp/ranges/filter_view
+//
+
+#ifndef cspan_pipeline_hpp
+#define cspan_pipeline_hpp
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "cspan_config.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Elements per block: each stage runs one tight loop over a block held
+//  in a stack buffer (L1-resident), which the compiler can vectorise.
+inline constexpr std::size_t pipeline_block { 256U };
+
+//  MARK: map_stage
+template<class In, class F>
+struct map_stage {
+  using output = std::remove_cvref_t<std::invoke_result_t<F const &, In const &>>;
+
+  template<class Next>
+  CSPAN_ALWAYS_INLINE void operator()(In const * const in, std::size_t const count, Next && next) {
+    std::array<output, pipeline_block> out;
+    for (std::size_t ix { 0U }; ix < count; ++ix) {
+      out[ix] = fn(in[ix]);
+    }
+    next(out.data(), count);
+  }
+
+  F fn;
+};
+
+//  MARK: filter_stage
+//  Branchless compaction: every element is written, the cursor only
+//  advances past the kept ones.
+template<class In, class P>
+struct filter_stage {
+  using output = In;
+
+  template<class Next>
+  CSPAN_ALWAYS_INLINE void operator()(In const * const in, std::size_t const count, Next && next) {
+    std::array<output, pipeline_block> out;
+    std::size_t kept { 0U };
+    for (std::size_t ix { 0U }; ix < count; ++ix) {
+      out[kept] = in[ix];
+      kept += static_cast<bool>(pred(in[ix])) ? 1U : 0U;
+    }
+    next(out.data(), kept);
+  }
+
+  P pred;
+};
+
+//  MARK: window_stage
+//  fn(window) for every `width`-wide window of the stream, windows
+//  spanning block boundaries included: the last width - 1 elements of
+//  each block are carried in front of the next, in a buffer sized for
+//  windows up to MaxWidth wide.
+template<class In, class F, std::size_t MaxWidth>
+struct window_stage {
+  using output = std::remove_cvref_t<std::invoke_result_t<F const &, std::span<In const>>>;
+
+  template<class Next>
+  void operator()(In const * const in, std::size_t const count, Next && next) {
+    std::copy_n(in, count, history.data() + held);
+    auto const total = held + count;
+    std::array<output, pipeline_block> out;
+    std::size_t made { 0U };
+    for (; made + width <= total; ++made) {
+      out[made] = fn(std::span<In const> { history.data() + made, width });
+    }
+    auto const keep = std::min(width - 1U, total);
+    if (keep != total) {
+      std::copy(history.data() + total - keep, history.data() + total, history.data());
+    }
+    held = keep;
+    if (made != 0U) {
+      next(out.data(), made);
+    }
+  }
+
+  std::size_t width;
+  F fn;
+  std::array<In, MaxWidth - 1U + pipeline_block> history {};
+  std::size_t held { 0U };
+};
+
+template<class T, class... Stages>
+struct pipeline_output {
+  using type = typename std::tuple_element_t<sizeof...(Stages) - 1U, std::tuple<Stages...>>::output;
+};
+
+template<class T>
+struct pipeline_output<T> {
+  using type = T;
+};
+
+//  Push one block through stages I.. and into `sink`.
+template<std::size_t I, class Tuple, class In, class Sink>
+CSPAN_ALWAYS_INLINE void run_stages(Tuple & stages, In const * const in, std::size_t const count, Sink & sink) {
+  if (count == 0U) {
+    return;
+  }
+  if constexpr (I == std::tuple_size_v<Tuple>) {
+    sink(in, count);
+  }
+  else {
+    std::get<I>(stages)(in, count, [&stages, &sink](auto const * const out, std::size_t const made) {
+      run_stages<I + 1U>(stages, out, made, sink);
+    });
+  }
+}
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+
+/*
+ *  MARK: pipeline
+ *  A lazy chain of stages over a span, evaluated in one fused pass by a
+ *  terminal (for_each, sum, reduce, count, collect):
+ *    auto const total = cspan::pipeline { std::span { data } }
+ *      .map([](int const val) { return val * val; })
+ *      .filter([](int const val) { return val % 3 == 0; })
+ *      .windows(4U, [](std::span<int const> const win) { return cspan::sum(win); })
+ *      .sum();
+ *  Building a stage copies the pipeline and does no work. Evaluation
+ *  takes the source pipeline_block elements at a time through every
+ *  stage, so intermediate values live in small stack buffers instead of
+ *  full-size arrays: one read of the source, no intermediate writes to
+ *  memory, nothing allocated. Stage functions are called by value on
+ *  const elements.
+ */
+template<class T, class... Stages>
+class pipeline {
+public:
+  using value_type = typename detail::pipeline_output<T, Stages...>::type;
+
+  template<std::size_t N>
+  explicit pipeline(std::span<T const, N> const source) noexcept
+    : source_ { source } {}
+
+  template<std::size_t N>
+    requires (!std::is_const_v<T>)
+  explicit pipeline(std::span<T, N> const source) noexcept
+    : source_ { source } {}
+
+  pipeline(std::span<T const> const source, std::tuple<Stages...> stages)
+    : source_ { source }, stages_ { std::move(stages) } {}
+
+  //  MARK: stages
+  template<class F>
+  [[nodiscard]]
+  auto map(F fn) const {
+    return append(detail::map_stage<value_type, F> { std::move(fn) });
+  }
+
+  template<class P>
+  [[nodiscard]]
+  auto filter(P pred) const {
+    return append(detail::filter_stage<value_type, P> { std::move(pred) });
+  }
+
+  //  fn(std::span<value_type const>) over every `width`-wide window;
+  //  width <= MaxWidth, which sizes the stage's carry-over buffer.
+  template<std::size_t MaxWidth = detail::pipeline_block, class F>
+  [[nodiscard]]
+  auto windows(std::size_t const width, F fn) const {
+    static_assert(MaxWidth != 0U, "pipeline::windows: MaxWidth must be positive");
+    assert(width != 0U && width <= MaxWidth);
+    return append(detail::window_stage<value_type, F, MaxWidth> { width, std::move(fn) });
+  }
+
+  //  MARK: terminals
+  //  sink(value_type const * data, std::size_t count) for each block.
+  template<class Sink>
+  void run(Sink sink) const {
+    auto stages = stages_;
+    auto const data = source_.data();
+    for (std::size_t first { 0U }; first < source_.size(); first += detail::pipeline_block) {
+      auto const count = std::min(detail::pipeline_block, source_.size() - first);
+      detail::run_stages<0U>(stages, data + first, count, sink);
+    }
+  }
+
+  template<class Fn>
+  void for_each(Fn fn) const {
+    run([&fn](value_type const * const data, std::size_t const count) {
+      for (std::size_t ix { 0U }; ix < count; ++ix) {
+        fn(data[ix]);
+      }
+    });
+  }
+
+  template<class R = value_type, class Op>
+  [[nodiscard]]
+  R reduce(R init, Op op) const {
+    run([&init, &op](value_type const * const data, std::size_t const count) {
+      for (std::size_t ix { 0U }; ix < count; ++ix) {
+        init = op(std::move(init), data[ix]);
+      }
+    });
+    return init;
+  }
+
+  template<class R = value_type>
+  [[nodiscard]]
+  R sum(R init = R {}) const {
+    run([&init](value_type const * const data, std::size_t const count) {
+      R block {};
+      for (std::size_t ix { 0U }; ix < count; ++ix) {
+        block += data[ix];
+      }
+      init += block;
+    });
+    return init;
+  }
+
+  [[nodiscard]]
+  std::size_t count() const {
+    std::size_t total { 0U };
+    run([&total](value_type const *, std::size_t const count) { total += count; });
+    return total;
+  }
+
+  //  Writes the results to `out`, which must be large enough; returns the
+  //  written prefix.
+  template<class U, std::size_t M>
+  std::span<U> collect(std::span<U, M> const out) const {
+    std::size_t written { 0U };
+    run([&out, &written](value_type const * const data, std::size_t const count) {
+      assert(count <= out.size() - written);
+      std::copy_n(data, count, out.data() + written);
+      written += count;
+    });
+    return std::span<U> { out }.first(written);
+  }
+
+private:
+  template<class Stage>
+  [[nodiscard]]
+  pipeline<T, Stages..., Stage> append(Stage stage) const {
+    return { source_, std::tuple_cat(stages_, std::tuple<Stage> { std::move(stage) }) };
+  }
+
+  std::span<T const> source_;
+  std::tuple<Stages...> stages_ {};
+};
+
+template<class T, std::size_t N>
+pipeline(std::span<T, N>) -> pipeline<std::remove_const_t<T>>;
+
+} /* namespace cspan */
+
+#endif /* cspan_pipeline_hpp */
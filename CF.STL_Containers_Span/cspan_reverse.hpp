@@ -0,0 +1,164 @@
+//
+//  cspan_reverse.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/algorithm/reverse
+//  @see: https://en.cppreference.com/w/cpp/algorithm/rotate
+//
+
+#ifndef cspan_reverse_hpp
+#define cspan_reverse_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Element types reversed as raw 1, 2, 4 or 8-byte lanes.
+template<class T>
+inline constexpr bool is_lane_reversible_v
+  = std::is_scalar_v<T> && !std::is_member_pointer_v<T>
+  && (sizeof(T) == 1U || sizeof(T) == 2U || sizeof(T) == 4U || sizeof(T) == 8U);
+
+//  Rotations whose shorter side fits here go through a stack buffer
+//  (one memmove of the longer side); larger ones reverse three times.
+inline constexpr std::size_t rotate_buffer { 4'096U };
+
+#if (CSPAN_HAS_TARGET)
+//  MARK: reverse_lanes_sse2() / reverse_lanes_avx2()
+//  Reverse the order of the Size-byte lanes of one register.
+template<std::size_t Size>
+CSPAN_TARGET("sse2")
+CSPAN_ALWAYS_INLINE __m128i reverse_lanes_sse2(__m128i vec) {
+  if constexpr (Size == 8U) {
+    return _mm_shuffle_epi32(vec, 0x4E);
+  }
+  else if constexpr (Size == 4U) {
+    return _mm_shuffle_epi32(vec, 0x1B);
+  }
+  else {
+    vec = _mm_shufflelo_epi16(vec, 0x1B);
+    vec = _mm_shufflehi_epi16(vec, 0x1B);
+    vec = _mm_shuffle_epi32(vec, 0x4E);
+    if constexpr (Size == 1U) {
+      vec = _mm_or_si128(_mm_slli_epi16(vec, 8), _mm_srli_epi16(vec, 8));
+    }
+    return vec;
+  }
+}
+
+template<std::size_t Size>
+CSPAN_TARGET("avx2")
+CSPAN_ALWAYS_INLINE __m256i reverse_lanes_avx2(__m256i vec) {
+  if constexpr (Size == 8U) {
+    return _mm256_permute4x64_epi64(vec, 0x1B);
+  }
+  else if constexpr (Size == 4U) {
+    return _mm256_permutevar8x32_epi32(vec, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+  else {
+    auto const mask = Size == 1U
+      ? _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+      : _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                         14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(vec, mask), 0x4E);
+  }
+}
+
+//  MARK: reverse_sse2() / reverse_avx2()
+//  Swap one register from each end of [lo, hi), each reversed in-register,
+//  until less than two registers remain. Returns the bytes done per end.
+template<std::size_t Size>
+CSPAN_TARGET("sse2")
+std::size_t reverse_sse2(unsigned char * lo, unsigned char * hi) {
+  auto const first = lo;
+  for (; hi - lo >= 32; lo += 16, hi -= 16) {
+    auto const front = _mm_loadu_si128(reinterpret_cast<__m128i const *>(lo));
+    auto const back = _mm_loadu_si128(reinterpret_cast<__m128i const *>(hi - 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lo), reverse_lanes_sse2<Size>(back));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hi - 16), reverse_lanes_sse2<Size>(front));
+  }
+  return static_cast<std::size_t>(lo - first);
+}
+
+template<std::size_t Size>
+CSPAN_TARGET("avx2")
+std::size_t reverse_avx2(unsigned char * lo, unsigned char * hi) {
+  auto const first = lo;
+  for (; hi - lo >= 64; lo += 32, hi -= 32) {
+    auto const front = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lo));
+    auto const back = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(hi - 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lo), reverse_lanes_avx2<Size>(back));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(hi - 32), reverse_lanes_avx2<Size>(front));
+  }
+  return static_cast<std::size_t>(lo - first);
+}
+#endif  /* (CSPAN_HAS_TARGET) */
+
+//  MARK: reverse_run()
+//  Runtime reversal: register-sized blocks from both ends, AVX2 then SSE2,
+//  with the middle (under 32 bytes) left to std::reverse.
+template<class T>
+void reverse_run(T * data, std::size_t const count) {
+#if (CSPAN_HAS_TARGET)
+  if constexpr (is_lane_reversible_v<T>) {
+    auto lo = reinterpret_cast<unsigned char *>(data);
+    auto hi = lo + count * sizeof(T);
+    if (cpu().avx2) {
+      auto const done = reverse_avx2<sizeof(T)>(lo, hi);
+      lo += done;
+      hi -= done;
+    }
+    auto const done = reverse_sse2<sizeof(T)>(lo, hi);
+    lo += done;
+    hi -= done;
+    std::reverse(reinterpret_cast<T *>(lo), reinterpret_cast<T *>(hi));
+    return;
+  }
+#endif  /* (CSPAN_HAS_TARGET) */
+  std::reverse(data, data + count);
+}
+
+//  MARK: rotate_run()
+//  Runtime left rotation of trivially copyable elements by `shift`.
+template<class T>
+void rotate_run(T * data, std::size_t const count, std::size_t const shift) {
+  auto const tail = count - shift;
+  if (std::min(shift, tail) * sizeof(T) <= rotate_buffer) {
+    alignas(32) unsigned char buffer[rotate_buffer];
+    if (shift <= tail) {
+      std::memcpy(buffer, data, shift * sizeof(T));
+      std::memmove(data, data + shift, tail * sizeof(T));
+      std::memcpy(data + tail, buffer, shift * sizeof(T));
+    }
+    else {
+      std::memcpy(buffer, data + shift, tail * sizeof(T));
+      std::memmove(data + tail, data, shift * sizeof(T));
+      std::memcpy(data, buffer, tail * sizeof(T));
+    }
+    return;
+  }
+  if constexpr (is_lane_reversible_v<T>) {
+    reverse_run(data, shift);
+    reverse_run(data + shift, tail);
+    reverse_run(data, count);
+  }
+  else {
+    std::rotate(data, data + shift, data + count);
+  }
+}
+
+} /* namespace detail */
+} /* namespace cspan */
+
+#endif /* cspan_reverse_hpp */
@@ -0,0 +1,358 @@
+//
+//  cspan_ring.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Circular_buffer#Optimization
+//  @see: https://man7.org/linux/man-pages/man2/memfd_create.2.html
+//  @see: https://lmax-exchange.github.io/disruptor/disruptor.html
+//
+
+#ifndef cspan_ring_hpp
+#define cspan_ring_hpp
+
+#include "cspan_config.hpp"
+#include "cspan_mapped.hpp"
+
+#if (CSPAN_HAS_MMAP)
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+/*
+ *  MARK: mirrored_buffer
+ *  `bytes` (a multiple of the page size) of shared memory mapped twice,
+ *  back to back: byte i and byte i + bytes are the same memory, so any
+ *  run of up to `bytes` starting inside the first copy is contiguous.
+ */
+class mirrored_buffer {
+public:
+  explicit mirrored_buffer(std::size_t const bytes)
+    : bytes_ { bytes } {
+    auto const fd = open_shared();
+    if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+      fail(fd, "ring ftruncate");
+    }
+    auto const area = ::mmap(nullptr, 2U * bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED) {
+      fail(fd, "ring mmap");
+    }
+    base_ = static_cast<std::byte *>(area);
+    for (auto * const half : { base_, base_ + bytes_, }) {
+      if (::mmap(half, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        auto const error = errno;
+        ::munmap(base_, 2U * bytes_);
+        errno = error;
+        fail(fd, "ring mmap");
+      }
+    }
+    ::close(fd);
+  }
+
+  mirrored_buffer(mirrored_buffer const &) = delete;
+  mirrored_buffer & operator=(mirrored_buffer const &) = delete;
+
+  ~mirrored_buffer() { ::munmap(base_, 2U * bytes_); }
+
+  [[nodiscard]]
+  std::byte * data() const noexcept { return base_; }
+
+  [[nodiscard]]
+  static std::size_t page_size() noexcept {
+    static auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+  }
+
+private:
+  //  An anonymous shared-memory file: memfd on Linux, else an unlinked
+  //  temporary file.
+  static int open_shared() {
+#if (defined(__linux__))
+    auto const fd = ::memfd_create("cspan_ring", MFD_CLOEXEC);
+#else
+    char name[] { "/tmp/cspan_ring.XXXXXX" };
+    auto const fd = ::mkstemp(name);
+    if (fd >= 0) {
+      ::unlink(name);
+    }
+#endif  /* (defined(__linux__)) */
+    if (fd < 0) {
+      throw std::system_error { errno, std::generic_category(), "ring shared memory" };
+    }
+    return fd;
+  }
+
+  [[noreturn]]
+  static void fail(int const fd, char const * const what) {
+    auto const error = errno;
+    ::close(fd);
+    throw std::system_error { error, std::generic_category(), what };
+  }
+
+  std::size_t bytes_;
+  std::byte * base_ { nullptr };
+};
+
+//  Spin, then yield: the waits below are for another thread's few
+//  instructions between claiming and publishing.
+inline void ring_pause(unsigned & spins) noexcept {
+  if (++spins < 64U) {
+#if (CSPAN_X86)
+    _mm_pause();
+#endif  /* (CSPAN_X86) */
+  }
+  else {
+    std::this_thread::yield();
+  }
+}
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+enum class ring_mode {
+  spsc,
+  mpmc,
+};
+
+/*
+ *  MARK: ring
+ *  A bounded queue of T between threads that hands out its storage as
+ *  spans, so batches are written and read in place:
+ *    producer:  auto out = queue.reserve(n);  fill out;  queue.commit(out);
+ *    consumer:  auto in = queue.peek();       use in;    queue.release(in);
+ *  The storage is mapped twice back to back, so every region reserve()
+ *  or peek() returns is one contiguous span, wrap-around or not.
+ *  Capacity is rounded up to a power of two whose bytes fill whole pages.
+ *
+ *  spsc: one producer thread and one consumer thread; every call is
+ *  wait-free. commit(n) / release(n) may hand back a prefix of what was
+ *  reserved / peeked.
+ *  mpmc: any number of each. reserve() and peek() claim their region
+ *  with a compare-exchange; commit() and release() publish regions in
+ *  claim order, so each waits for earlier claimants to publish theirs,
+ *  and must be given the whole span that was claimed.
+ *
+ *  reserve(n) returns an empty span when n elements are not free;
+ *  peek() one when nothing is readable. T must be trivially copyable.
+ */
+template<class T, ring_mode Mode = ring_mode::spsc>
+class ring {
+  static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                "ring elements must be trivially copyable");
+
+public:
+  using value_type = T;
+
+  static std::size_t constexpr npos { static_cast<std::size_t>(-1) };
+
+  //  Errors mapping the storage throw std::system_error.
+  explicit ring(std::size_t const capacity)
+    : capacity_ { round_capacity(capacity) },
+      mask_ { capacity_ - 1U },
+      buffer_ { capacity_ * sizeof(T) },
+      data_ { reinterpret_cast<T *>(buffer_.data()) } {}
+
+  ring(ring const &) = delete;
+  ring & operator=(ring const &) = delete;
+
+  [[nodiscard]]
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  //  Committed, not yet released; a snapshot when other threads are active.
+  //  head is read first, so the tail read after it is never behind it;
+  //  by then both may have moved on, hence the clamp to capacity.
+  [[nodiscard]]
+  std::size_t size() const noexcept {
+    auto const head = head_.value.load(std::memory_order_acquire);
+    auto const tail = tail_.value.load(std::memory_order_acquire);
+    return std::min(tail - head, capacity_);
+  }
+
+  //  MARK: producer
+  [[nodiscard]]
+  std::span<T> reserve(std::size_t const count) noexcept {
+    if (count == 0U || count > capacity_) {
+      return {};
+    }
+    if constexpr (Mode == ring_mode::spsc) {
+      auto const tail = tail_.value.load(std::memory_order_relaxed);
+      if (capacity_ - (tail - tail_.cache) < count) {
+        tail_.cache = head_.value.load(std::memory_order_acquire);
+        if (capacity_ - (tail - tail_.cache) < count) {
+          return {};
+        }
+      }
+      return { data_ + (tail & mask_), count };
+    }
+    else {
+      auto claim = write_claim_.value.load(std::memory_order_relaxed);
+      do {
+        if (capacity_ - (claim - head_.value.load(std::memory_order_acquire)) < count) {
+          return {};
+        }
+      } while (!write_claim_.value.compare_exchange_weak(claim, claim + count, std::memory_order_relaxed));
+      return { data_ + (claim & mask_), count };
+    }
+  }
+
+  //  spsc: publish the first `count` reserved elements.
+  void commit(std::size_t const count) noexcept
+    requires (Mode == ring_mode::spsc) {
+    auto const tail = tail_.value.load(std::memory_order_relaxed);
+    assert(count <= capacity_ - (tail - tail_.cache));
+    tail_.value.store(tail + count, std::memory_order_release);
+  }
+
+  //  Publish a span returned by reserve() (spsc: or a prefix of one).
+  void commit(std::span<T> const reserved) noexcept {
+    if (reserved.empty()) {
+      return;
+    }
+    if constexpr (Mode == ring_mode::spsc) {
+      commit(reserved.size());
+    }
+    else {
+      auto const at = position(reserved.data(), tail_.value.load(std::memory_order_acquire));
+      unsigned spins { 0U };
+      while (tail_.value.load(std::memory_order_acquire) != at) {
+        detail::ring_pause(spins);
+      }
+      tail_.value.store(at + reserved.size(), std::memory_order_release);
+    }
+  }
+
+  //  reserve + copy + commit; false (nothing written) if `values` do not fit.
+  [[nodiscard]]
+  bool push(std::span<T const> const values) noexcept {
+    auto const out = reserve(values.size());
+    if (out.size() != values.size()) {
+      return values.empty();
+    }
+    std::copy(values.begin(), values.end(), out.begin());
+    commit(out);
+    return true;
+  }
+
+  //  MARK: consumer
+  //  Up to `most` readable elements (mpmc: claimed by this caller).
+  [[nodiscard]]
+  std::span<T const> peek(std::size_t const most = npos) noexcept {
+    if constexpr (Mode == ring_mode::spsc) {
+      auto const head = head_.value.load(std::memory_order_relaxed);
+      if (head_.cache == head) {
+        head_.cache = tail_.value.load(std::memory_order_acquire);
+      }
+      return { data_ + (head & mask_), std::min(most, head_.cache - head) };
+    }
+    else {
+      auto claim = read_claim_.value.load(std::memory_order_relaxed);
+      std::size_t take { 0U };
+      do {
+        take = std::min(most, tail_.value.load(std::memory_order_acquire) - claim);
+        if (take == 0U) {
+          return {};
+        }
+      } while (!read_claim_.value.compare_exchange_weak(claim, claim + take, std::memory_order_relaxed));
+      return { data_ + (claim & mask_), take };
+    }
+  }
+
+  //  spsc: free the first `count` peeked elements.
+  void release(std::size_t const count) noexcept
+    requires (Mode == ring_mode::spsc) {
+    auto const head = head_.value.load(std::memory_order_relaxed);
+    assert(count <= head_.cache - head);
+    head_.value.store(head + count, std::memory_order_release);
+  }
+
+  //  Free a span returned by peek() (spsc: or a prefix of one).
+  void release(std::span<T const> const peeked) noexcept {
+    if (peeked.empty()) {
+      return;
+    }
+    if constexpr (Mode == ring_mode::spsc) {
+      release(peeked.size());
+    }
+    else {
+      auto const at = position(peeked.data(), head_.value.load(std::memory_order_acquire));
+      unsigned spins { 0U };
+      while (head_.value.load(std::memory_order_acquire) != at) {
+        detail::ring_pause(spins);
+      }
+      head_.value.store(at + peeked.size(), std::memory_order_release);
+    }
+  }
+
+  //  peek + copy + release of up to out.size() elements; returns the count.
+  [[nodiscard]]
+  std::size_t pop(std::span<T> const out) noexcept {
+    if (out.empty()) {
+      return 0U;
+    }
+    auto const in = peek(out.size());
+    std::copy(in.begin(), in.end(), out.begin());
+    release(in);
+    return in.size();
+  }
+
+private:
+  struct alignas(64) counter {
+    std::atomic<std::size_t> value { 0U };
+    //  spsc: the other side's counter as last seen (tail_: the head, head_:
+    //  the tail), re-read only when it is not enough.
+    std::size_t cache { 0U };
+  };
+
+  [[nodiscard]]
+  static std::size_t round_capacity(std::size_t const capacity) {
+    auto const page = detail::mirrored_buffer::page_size();
+    auto rounded = std::bit_ceil(std::max<std::size_t>(capacity, 1U));
+    while (rounded * sizeof(T) % page != 0U) {
+      rounded *= 2U;
+    }
+    return rounded;
+  }
+
+  //  The absolute position of an unpublished claim from its address: it
+  //  lies in [published, published + capacity), where positions and ring
+  //  indices correspond one to one.
+  [[nodiscard]]
+  std::size_t position(T const * const at, std::size_t const published) const noexcept {
+    auto const index = static_cast<std::size_t>(at - data_);
+    return published + ((index - published) & mask_);
+  }
+
+  std::size_t capacity_;
+  std::size_t mask_;
+  detail::mirrored_buffer buffer_;
+  T * data_;
+
+  counter tail_ {};
+  counter head_ {};
+  counter write_claim_ {};
+  counter read_claim_ {};
+};
+
+} /* namespace cspan */
+
+#endif  /* (CSPAN_HAS_MMAP) */
+
+#endif /* cspan_ring_hpp */
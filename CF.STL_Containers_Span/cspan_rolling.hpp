@@ -0,0 +1,309 @@
+//
+//  cspan_rolling.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/Prefix_sum
+//  @see: https://en.wikipedia.org/wiki/Sliding_window_based_part-of-speech_tagging
+//
+
+#ifndef cspan_rolling_hpp
+#define cspan_rolling_hpp
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "cspan_config.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Number of `width`-wide windows in `size` elements.
+[[nodiscard]]
+constexpr std::size_t window_count(std::size_t const size, std::size_t const width) noexcept {
+  return size < width ? 0U : size - width + 1U;
+}
+
+//  Floating-point running sums drift; re-anchor with an exact window sum
+//  at least this often. Spacing anchors >= width keeps the total O(N).
+inline constexpr std::size_t rolling_anchor { 4'096U };
+
+//  Integer sums are carried in the unsigned counterpart of R, so overflow
+//  wraps modulo 2^bits, as it does in the SIMD kernels, instead of being
+//  undefined for signed R.
+template<class R>
+using rolling_sum_t = typename std::conditional_t<std::is_integral_v<R>,
+                                                  std::make_unsigned<R>, std::type_identity<R>>::type;
+
+template<class R, class T>
+[[nodiscard]]
+constexpr rolling_sum_t<R> rolling_term(T const value) noexcept {
+  return static_cast<rolling_sum_t<R>>(static_cast<R>(value));
+}
+
+//  MARK: rolling_sum_first()
+//  The sum of in[first, first + width), from scratch.
+template<class T, class R>
+[[nodiscard]]
+constexpr R rolling_sum_first(T const * in, std::size_t const width, std::size_t const first) {
+  rolling_sum_t<R> sum {};
+  for (auto ix { first }; ix != first + width; ++ix) {
+    sum = static_cast<rolling_sum_t<R>>(sum + rolling_term<R>(in[ix]));
+  }
+  return static_cast<R>(sum);
+}
+
+//  MARK: rolling_sum_scalar()
+//  out[ix] = out[ix - 1] + in[ix + width - 1] - in[ix - 1], ix in [first, last)
+template<class T, class R>
+constexpr void rolling_sum_scalar(T const * in, std::size_t const width, R * out,
+                                  std::size_t first, std::size_t const last) {
+  for (; first < last; ++first) {
+    out[first] = static_cast<R>(static_cast<rolling_sum_t<R>>(
+      static_cast<rolling_sum_t<R>>(out[first - 1U])
+      + rolling_term<R>(in[first + width - 1U]) - rolling_term<R>(in[first - 1U])));
+  }
+}
+
+#if (CSPAN_HAS_TARGET)
+//  MARK: rolling_sum_sse2() / rolling_sum_avx2()
+//  The same recurrence as a prefix scan: the element differences are
+//  computed four (eight) at a time, scanned in-register with log2(lanes)
+//  shift-and-add steps, and offset by the carried previous sum.
+//  Returns the first index left for the scalar tail.
+template<class R>
+CSPAN_TARGET("sse2")
+std::size_t rolling_sum_sse2(R const * in, std::size_t const width, R * out,
+                             std::size_t first, std::size_t const last) {
+  if constexpr (std::is_floating_point_v<R>) {
+    auto carry = _mm_set1_ps(out[first - 1U]);
+    for (; first + 4U <= last; first += 4U) {
+      auto dif = _mm_sub_ps(_mm_loadu_ps(in + first + width - 1U), _mm_loadu_ps(in + first - 1U));
+      dif = _mm_add_ps(dif, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(dif), 4)));
+      dif = _mm_add_ps(dif, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(dif), 8)));
+      auto const sum = _mm_add_ps(dif, carry);
+      _mm_storeu_ps(out + first, sum);
+      carry = _mm_shuffle_ps(sum, sum, 0xFF);
+    }
+  }
+  else {
+    auto carry = _mm_set1_epi32(static_cast<std::int32_t>(out[first - 1U]));
+    for (; first + 4U <= last; first += 4U) {
+      auto dif = _mm_sub_epi32(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + first + width - 1U)),
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + first - 1U)));
+      dif = _mm_add_epi32(dif, _mm_slli_si128(dif, 4));
+      dif = _mm_add_epi32(dif, _mm_slli_si128(dif, 8));
+      auto const sum = _mm_add_epi32(dif, carry);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + first), sum);
+      carry = _mm_shuffle_epi32(sum, 0xFF);
+    }
+  }
+  return first;
+}
+
+//  In-register inclusive scan of eight 32-bit lanes: two shift-and-add
+//  steps per 128-bit half, then the low half's total is added to the high.
+CSPAN_TARGET("avx2")
+CSPAN_ALWAYS_INLINE __m256i prefix8(__m256i dif) {
+  dif = _mm256_add_epi32(dif, _mm256_slli_si256(dif, 4));
+  dif = _mm256_add_epi32(dif, _mm256_slli_si256(dif, 8));
+  return _mm256_add_epi32(dif, _mm256_shuffle_epi32(_mm256_permute2x128_si256(dif, dif, 0x08), 0xFF));
+}
+
+CSPAN_TARGET("avx2")
+CSPAN_ALWAYS_INLINE __m256 prefix8(__m256 dif) {
+  dif = _mm256_add_ps(dif, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(dif), 4)));
+  dif = _mm256_add_ps(dif, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(dif), 8)));
+  auto const low = _mm256_permute2x128_si256(_mm256_castps_si256(dif), _mm256_castps_si256(dif), 0x08);
+  return _mm256_add_ps(dif, _mm256_castsi256_ps(_mm256_shuffle_epi32(low, 0xFF)));
+}
+
+template<class R>
+CSPAN_TARGET("avx2")
+std::size_t rolling_sum_avx2(R const * in, std::size_t const width, R * out,
+                             std::size_t first, std::size_t const last) {
+  auto const top = _mm256_set1_epi32(7);
+  if constexpr (std::is_floating_point_v<R>) {
+    auto carry = _mm256_set1_ps(out[first - 1U]);
+    for (; first + 8U <= last; first += 8U) {
+      auto const dif = _mm256_sub_ps(_mm256_loadu_ps(in + first + width - 1U),
+                                     _mm256_loadu_ps(in + first - 1U));
+      auto const sum = _mm256_add_ps(prefix8(dif), carry);
+      _mm256_storeu_ps(out + first, sum);
+      carry = _mm256_permutevar8x32_ps(sum, top);
+    }
+  }
+  else {
+    auto carry = _mm256_set1_epi32(static_cast<std::int32_t>(out[first - 1U]));
+    for (; first + 8U <= last; first += 8U) {
+      auto const dif = _mm256_sub_epi32(
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + first + width - 1U)),
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + first - 1U)));
+      auto const sum = _mm256_add_epi32(prefix8(dif), carry);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + first), sum);
+      carry = _mm256_permutevar8x32_epi32(sum, top);
+    }
+  }
+  return first;
+}
+#endif  /* (CSPAN_HAS_TARGET) */
+
+//  MARK: rolling_sum_run()
+template<class T, class R>
+void rolling_sum_run(T const * in, std::size_t const width, R * out,
+                     std::size_t first, std::size_t const last) {
+#if (CSPAN_HAS_TARGET)
+  using value_type = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<value_type, R>
+                && (std::is_same_v<R, float> || std::is_same_v<R, std::int32_t>
+                    || std::is_same_v<R, std::uint32_t>)) {
+    first = cpu().avx2
+      ? rolling_sum_avx2<R>(in, width, out, first, last)
+      : rolling_sum_sse2<R>(in, width, out, first, last);
+  }
+#endif  /* (CSPAN_HAS_TARGET) */
+  rolling_sum_scalar(in, width, out, first, last);
+}
+
+/*
+ *  MARK: monotonic_deque
+ *  Candidates for a window extreme as (index, value) pairs in a power-of-two
+ *  ring, one slot wider than the window since a push precedes the expiry.
+ *  Values are kept ordered by `Compare`; caching them beside the index
+ *  keeps the eviction loop free of dependent loads.
+ */
+template<class T, class Compare>
+class monotonic_deque {
+public:
+  using value_type = std::remove_cv_t<T>;
+
+  explicit monotonic_deque(std::size_t const width)
+    : index_(std::bit_ceil(width + 1U)), value_(index_.size()),
+      mask_ { index_.size() - 1U } {}
+
+  //  Admit `value` at `ix`, evicting every candidate it dominates.
+  void push(std::size_t const ix, value_type const value, Compare const & cmp) {
+    while (head_ != tail_ && !cmp(value_[(tail_ - 1U) & mask_], value)) {
+      --tail_;
+    }
+    index_[tail_ & mask_] = ix;
+    value_[tail_ & mask_] = value;
+    ++tail_;
+  }
+
+  //  Drop the front once it falls out of a window starting at `start`.
+  void expire(std::size_t const start) {
+    head_ += index_[head_ & mask_] < start ? 1U : 0U;
+  }
+
+  [[nodiscard]]
+  value_type front() const { return value_[head_ & mask_]; }
+
+private:
+  std::vector<std::size_t> index_;
+  std::vector<value_type> value_;
+  std::size_t mask_;
+  std::size_t head_ { 0U };
+  std::size_t tail_ { 0U };
+};
+
+//  MARK: rolling_extreme()
+template<class T, class R, class Compare>
+std::span<R> rolling_extreme(std::span<T const> in, std::size_t const width,
+                             std::span<R> out, Compare cmp) {
+  assert(width != 0U);
+  auto const count = window_count(in.size(), width);
+  assert(out.size() >= count);
+  if (count == 0U) {
+    return out.first(0U);
+  }
+
+  monotonic_deque<T, Compare> deque { width };
+  for (std::size_t ix { 0U }; ix != width - 1U; ++ix) {
+    deque.push(ix, in[ix], cmp);
+  }
+  for (std::size_t ix { 0U }; ix != count; ++ix) {
+    deque.push(ix + width - 1U, in[ix + width - 1U], cmp);
+    deque.expire(ix);
+    out[ix] = static_cast<R>(deque.front());
+  }
+  return out.first(count);
+}
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+//  Each rolling_* writes one result per `width`-wide window of `in` (stride 1)
+//  into `out`, which must hold in.size() - width + 1 elements, and returns
+//  the written prefix of `out`. O(N) in total, independent of the width.
+
+//  MARK: rolling_sum()
+//  Sums accumulate in R; integer sums wrap on overflow, signed or not.
+//  32-bit int / float inputs summed into the same type run an SSE2 / AVX2
+//  prefix-scan kernel.
+template<class T, std::size_t N, class R, std::size_t M>
+std::span<R> rolling_sum(std::span<T, N> in, std::size_t const width,
+                         std::span<R, M> out) {
+  assert(width != 0U);
+  auto const count = detail::window_count(in.size(), width);
+  assert(out.size() >= count);
+  if (count == 0U) {
+    return std::span<R> { out }.first(0U);
+  }
+
+  auto const src = in.data();
+  auto const dst = out.data();
+  //  Integers are exact modulo 2^bits and need a single anchor.
+  auto const segment = std::is_floating_point_v<R>
+    ? std::max(width, detail::rolling_anchor)
+    : count;
+  for (std::size_t first { 0U }; first < count; first += segment) {
+    dst[first] = detail::rolling_sum_first<std::remove_cv_t<T>, R>(src, width, first);
+    detail::rolling_sum_run(src, width, dst, first + 1U,
+                            std::min(first + segment, count));
+  }
+  return std::span<R> { out }.first(count);
+}
+
+//  MARK: rolling_mean()
+template<class T, std::size_t N, class R, std::size_t M>
+std::span<R> rolling_mean(std::span<T, N> in, std::size_t const width,
+                          std::span<R, M> out) {
+  static_assert(std::is_floating_point_v<R>, "rolling_mean needs a floating-point output");
+  auto const sums = rolling_sum(in, width, out);
+  auto const scale = R { 1 } / static_cast<R>(width);
+  std::transform(sums.begin(), sums.end(), sums.begin(), [scale](R const sum) {
+    return sum * scale;
+  });
+  return sums;
+}
+
+//  MARK: rolling_min() / rolling_max()
+template<class T, std::size_t N, class R, std::size_t M>
+std::span<R> rolling_min(std::span<T, N> in, std::size_t const width,
+                         std::span<R, M> out) {
+  return detail::rolling_extreme(std::span<T const> { in }, width,
+                                 std::span<R> { out }, std::less<> {});
+}
+
+template<class T, std::size_t N, class R, std::size_t M>
+std::span<R> rolling_max(std::span<T, N> in, std::size_t const width,
+                         std::span<R, M> out) {
+  return detail::rolling_extreme(std::span<T const> { in }, width,
+                                 std::span<R> { out }, std::greater<> {});
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_rolling_hpp */
@@ -0,0 +1,543 @@
+//
+//  cspan_search.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: http://0x80.pl/articles/simd-strfind.html
+//  @see: https://en.wikipedia.org/wiki/Two-way_string-matching_algorithm
+//
+
+#ifndef cspan_search_hpp
+#define cspan_search_hpp
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#include "cspan_config.hpp"
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Needles up to this many elements use the SIMD first/last filter,
+//  longer ones the Two-Way matcher (linear even on repetitive data).
+inline constexpr std::size_t short_needle_max { 32U };
+
+//  MARK: key()
+//  A totally ordered stand-in for a bitwise comparable element.
+template<class T>
+[[nodiscard]]
+constexpr auto key(T const value) {
+  if constexpr (std::is_enum_v<T>) {
+    return static_cast<std::underlying_type_t<T>>(value);
+  }
+  else if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<std::uintptr_t>(value);
+  }
+  else {
+    return value;
+  }
+}
+
+//  MARK: find_scalar()
+template<class T>
+[[nodiscard]]
+constexpr std::size_t find_scalar(std::span<T const> hay,
+                                  std::span<T const> needle) {
+  return static_cast<std::size_t>(std::search(hay.begin(), hay.end(),
+                                              needle.begin(), needle.end())
+                                  - hay.begin());
+}
+
+//  MARK: find_element()
+template<class T>
+[[nodiscard]]
+std::size_t find_element(std::span<T const> hay, T const value) {
+  if constexpr (sizeof(T) == 1U) {
+    auto const byte = static_cast<unsigned char>(key(value));
+    auto const hit = std::memchr(hay.data(), byte, hay.size());
+    return hit == nullptr
+      ? hay.size()
+      : static_cast<std::size_t>(static_cast<unsigned char const *>(hit)
+                                 - reinterpret_cast<unsigned char const *>(hay.data()));
+  }
+  else {
+    return static_cast<std::size_t>(std::find(hay.begin(), hay.end(), value)
+                                    - hay.begin());
+  }
+}
+
+//  MARK: element_mask()
+//  Collapse a per-byte equality mask into one bit (the lowest) per
+//  element of Size bytes: an element matches when all its bytes do.
+template<std::size_t Size, class M>
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE M element_mask(M mask) {
+  if constexpr (Size == 1U) {
+    return mask;
+  }
+  else if constexpr (Size == 2U) {
+    return mask & (mask >> 1) & static_cast<M>(0x5555'5555'5555'5555ULL);
+  }
+  else if constexpr (Size == 4U) {
+    mask &= mask >> 1;
+    mask &= mask >> 2;
+    return mask & static_cast<M>(0x1111'1111'1111'1111ULL);
+  }
+  else {
+    mask &= mask >> 1;
+    mask &= mask >> 2;
+    mask &= mask >> 4;
+    return mask & static_cast<M>(0x0101'0101'0101'0101ULL);
+  }
+}
+
+//  MARK: verify()
+//  Candidate at element `pos`: first and last elements already match.
+template<std::size_t Size>
+[[nodiscard]]
+CSPAN_ALWAYS_INLINE bool verify(unsigned char const * hay, std::size_t pos,
+                                unsigned char const * needle, std::size_t len) {
+  return len <= 2U
+    || std::memcmp(hay + (pos + 1U) * Size, needle + Size, (len - 2U) * Size) == 0;
+}
+
+/*
+ *  MARK: broadcast_pattern
+ *  The needle's first and last element replicated across a 32-byte vector,
+ *  built once and loaded directly by the SSE2 / AVX2 kernels.
+ */
+struct broadcast_pattern {
+  alignas(32) unsigned char first[32] {};
+  alignas(32) unsigned char last[32] {};
+
+  broadcast_pattern() = default;
+
+  broadcast_pattern(unsigned char const * needle, std::size_t len,
+                    std::size_t size) {
+    for (std::size_t ix { 0U }; ix != sizeof(first); ++ix) {
+      first[ix] = needle[ix % size];
+      last[ix]  = needle[(len - 1U) * size + ix % size];
+    }
+  }
+};
+
+#if (CSPAN_HAS_TARGET)
+//  MARK: find_first_last_sse2()
+//  Compare 16-byte blocks against broadcasts of the needle's first and last
+//  element; only positions where both hit are verified with memcmp.
+//  Returns the match position, or `count` with `scanned` set to the number
+//  of positions ruled out so the caller can finish the tail in scalar code.
+template<std::size_t Size>
+CSPAN_TARGET("sse2")
+std::size_t find_first_last_sse2(unsigned char const * hay, std::size_t count,
+                                 unsigned char const * needle, std::size_t len,
+                                 broadcast_pattern const & pattern,
+                                 std::size_t & scanned) {
+  std::size_t constexpr lanes { 16U / Size };
+  auto const first = _mm_load_si128(reinterpret_cast<__m128i const *>(pattern.first));
+  auto const last  = _mm_load_si128(reinterpret_cast<__m128i const *>(pattern.last));
+
+  std::size_t pos {};
+  for (; pos + len - 1U + lanes <= count; pos += lanes) {
+    auto const blk_f = _mm_loadu_si128(reinterpret_cast<__m128i const *>(hay + pos * Size));
+    auto const blk_l = _mm_loadu_si128(reinterpret_cast<__m128i const *>(hay + (pos + len - 1U) * Size));
+    auto const eq = _mm_and_si128(_mm_cmpeq_epi8(blk_f, first), _mm_cmpeq_epi8(blk_l, last));
+    auto mask = element_mask<Size>(static_cast<std::uint32_t>(_mm_movemask_epi8(eq)));
+    while (mask != 0U) {
+      auto const at = pos + static_cast<std::size_t>(__builtin_ctz(mask)) / Size;
+      if (verify<Size>(hay, at, needle, len)) {
+        return at;
+      }
+      mask &= mask - 1U;
+    }
+  }
+  scanned = pos;
+  return count;
+}
+
+//  MARK: find_first_last_avx2()
+template<std::size_t Size>
+CSPAN_TARGET("avx2")
+std::size_t find_first_last_avx2(unsigned char const * hay, std::size_t count,
+                                 unsigned char const * needle, std::size_t len,
+                                 broadcast_pattern const & pattern,
+                                 std::size_t & scanned) {
+  std::size_t constexpr lanes { 32U / Size };
+  auto const first = _mm256_load_si256(reinterpret_cast<__m256i const *>(pattern.first));
+  auto const last  = _mm256_load_si256(reinterpret_cast<__m256i const *>(pattern.last));
+
+  std::size_t pos {};
+  for (; pos + len - 1U + lanes <= count; pos += lanes) {
+    auto const blk_f = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(hay + pos * Size));
+    auto const blk_l = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(hay + (pos + len - 1U) * Size));
+    auto const eq = _mm256_and_si256(_mm256_cmpeq_epi8(blk_f, first), _mm256_cmpeq_epi8(blk_l, last));
+    auto mask = element_mask<Size>(static_cast<std::uint32_t>(_mm256_movemask_epi8(eq)));
+    while (mask != 0U) {
+      auto const at = pos + static_cast<std::size_t>(__builtin_ctz(mask)) / Size;
+      if (verify<Size>(hay, at, needle, len)) {
+        return at;
+      }
+      mask &= mask - 1U;
+    }
+  }
+  scanned = pos;
+  return count;
+}
+#endif  /* (CSPAN_HAS_TARGET) */
+
+//  MARK: find_first_last()
+//  SIMD first/last-element filter with scalar tail; bitwise comparable T only.
+template<class T>
+[[nodiscard]]
+std::size_t find_first_last(std::span<T const> hay, std::span<T const> needle,
+                            broadcast_pattern const & pattern) {
+  std::size_t scanned {};
+#if (CSPAN_HAS_TARGET)
+  auto const bytes = reinterpret_cast<unsigned char const *>(hay.data());
+  auto const elems = reinterpret_cast<unsigned char const *>(needle.data());
+  auto const found = cpu().avx2
+    ? find_first_last_avx2<sizeof(T)>(bytes, hay.size(), elems, needle.size(), pattern, scanned)
+    : find_first_last_sse2<sizeof(T)>(bytes, hay.size(), elems, needle.size(), pattern, scanned);
+  if (found != hay.size()) {
+    return found;
+  }
+#else
+  static_cast<void>(pattern);
+#endif  /* (CSPAN_HAS_TARGET) */
+  return scanned + find_scalar(hay.subspan(scanned), needle);
+}
+
+//  MARK: bucket()
+//  Fold an element into one of 256 skip-table slots.
+template<class T>
+[[nodiscard]]
+constexpr std::uint8_t bucket(T const value) {
+  auto const k_ = key(value);
+  if constexpr (sizeof(k_) == 1U) {
+    return static_cast<std::uint8_t>(k_);
+  }
+  else {
+    auto hx = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<decltype(k_)>>(k_));
+    hx ^= hx >> 32U;
+    hx ^= hx >> 16U;
+    hx ^= hx >> 8U;
+    return static_cast<std::uint8_t>(hx);
+  }
+}
+
+/*
+ *  MARK: skip_table
+ *  Horspool bad-character shifts, keyed by bucket(). Colliding elements
+ *  share the smallest shift, which keeps every skip safe.
+ */
+struct skip_table {
+  std::array<std::size_t, 256U> shift {};
+
+  skip_table() = default;
+
+  template<class T>
+  explicit constexpr skip_table(std::span<T const> needle) {
+    shift.fill(needle.size());
+    for (std::size_t ix { 0U }; ix != needle.size(); ++ix) {
+      shift[bucket(needle[ix])] = needle.size() - ix - 1U;
+    }
+  }
+};
+
+/*
+ *  MARK: two_way
+ *  Crochemore-Perrin critical factorisation of a needle.
+ *  O(1) extra space, O(n + m) worst case.
+ */
+template<class T>
+struct two_way {
+  std::size_t ms { static_cast<std::size_t>(-1) };  // critical position - 1
+  std::size_t period { 1U };
+  std::size_t mem0 { 0U };                          // > 0: needle is periodic
+
+  constexpr two_way() = default;
+
+  explicit constexpr two_way(std::span<T const> needle) {
+    auto const len = needle.size();
+    auto const maximal_suffix = [&](auto less, std::size_t & per) {
+      std::size_t ip { static_cast<std::size_t>(-1) };
+      std::size_t jp { 0U };
+      std::size_t kk { 1U };
+      per = 1U;
+      while (jp + kk < len) {
+        auto const lhs = key(needle[ip + kk]);
+        auto const rhs = key(needle[jp + kk]);
+        if (lhs == rhs) {
+          if (kk == per) {
+            jp += per;
+            kk = 1U;
+          }
+          else {
+            ++kk;
+          }
+        }
+        else if (less(rhs, lhs)) {
+          jp += kk;
+          kk = 1U;
+          per = jp - ip;
+        }
+        else {
+          ip = jp++;
+          kk = per = 1U;
+        }
+      }
+      return ip;
+    };
+
+    std::size_t per_lt {};
+    std::size_t per_gt {};
+    auto const ms_lt = maximal_suffix(std::less<> {}, per_lt);
+    auto const ms_gt = maximal_suffix(std::greater<> {}, per_gt);
+    if (ms_gt + 1U > ms_lt + 1U) {
+      ms = ms_gt;
+      period = per_gt;
+    }
+    else {
+      ms = ms_lt;
+      period = per_lt;
+    }
+
+    if (std::equal(needle.begin(), needle.begin() + (ms + 1U),
+                   needle.begin() + period)) {
+      mem0 = len - period;
+    }
+    else {
+      mem0 = 0U;
+      period = std::max(ms, len - ms - 1U) + 1U;
+    }
+  }
+
+  //  Report every (possibly overlapping) occurrence to `on_match(pos)`,
+  //  stopping early when it returns false. `skip` adds Horspool shifts
+  //  on the element under the needle's last position.
+  template<class Fn>
+  constexpr void scan(std::span<T const> hay, std::span<T const> needle,
+                      skip_table const * skip, Fn && on_match) const {
+    auto const len = needle.size();
+    std::size_t mem { 0U };
+    for (std::size_t pos { 0U }; hay.size() - pos >= len; ) {
+      if (skip != nullptr) {
+        auto const shift = skip->shift[bucket(hay[pos + len - 1U])];
+        if (shift != 0U) {
+          pos += std::max(shift, mem);
+          mem = 0U;
+          continue;
+        }
+      }
+      // Right half, left to right.
+      auto kk = std::max(ms + 1U, mem);
+      while (kk < len && needle[kk] == hay[pos + kk]) {
+        ++kk;
+      }
+      if (kk < len) {
+        pos += kk - ms;
+        mem = 0U;
+        continue;
+      }
+      // Left half, right to left.
+      kk = ms + 1U;
+      while (kk > mem && needle[kk - 1U] == hay[pos + kk - 1U]) {
+        --kk;
+      }
+      if (kk <= mem && !on_match(pos)) {
+        return;
+      }
+      pos += period;
+      mem = mem0;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr std::size_t find(std::span<T const> hay, std::span<T const> needle,
+                             skip_table const * skip = nullptr) const {
+    auto found { hay.size() };
+    scan(hay, needle, skip, [&found](std::size_t const pos) {
+      found = pos;
+      return false;
+    });
+    return found;
+  }
+};
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+/*
+ *  MARK: searcher
+ *  A needle preprocessed once - strategy, SIMD broadcast pattern, Two-Way
+ *  factorisation and Horspool skip table - then matched against any number
+ *  of haystacks. Like the std:: searchers it refers to the needle, which
+ *  must outlive the searcher.
+ *  Matches may overlap; an empty needle matches at every offset.
+ */
+template<class T>
+class searcher {
+public:
+  using value_type = std::remove_cv_t<T>;
+
+  static std::size_t constexpr npos { static_cast<std::size_t>(-1) };
+
+  explicit searcher(std::span<T const> needle)
+    : needle_ { needle } {
+    if constexpr (vectorizable) {
+      if (needle_.size() == 1U) {
+        strategy_ = strategy::element;
+      }
+      else if (needle_.size() > 1U && needle_.size() <= detail::short_needle_max) {
+        strategy_ = strategy::first_last;
+        pattern_ = detail::broadcast_pattern {
+          reinterpret_cast<unsigned char const *>(needle_.data()),
+          needle_.size(), sizeof(value_type) };
+      }
+      else if (needle_.size() > detail::short_needle_max) {
+        strategy_ = strategy::two_way;
+        two_way_ = detail::two_way<T> { needle_ };
+        skip_ = detail::skip_table { needle_ };
+      }
+    }
+    if (needle_.empty()) {
+      strategy_ = strategy::empty;
+    }
+  }
+
+  [[nodiscard]]
+  std::span<T const> needle() const noexcept { return needle_; }
+
+  [[nodiscard]]
+  bool contains(std::span<T const> hay) const {
+    return find_first(hay) != npos;
+  }
+
+  //  Offset of the first match, npos if there is none.
+  [[nodiscard]]
+  std::size_t find_first(std::span<T const> hay) const {
+    auto found { npos };
+    scan(hay, [&found](std::size_t const pos) {
+      found = pos;
+      return false;
+    });
+    return found;
+  }
+
+  //  Write match offsets into `out` until it is full, without allocating.
+  //  Returns the filled prefix of `out`.
+  [[nodiscard]]
+  std::span<std::size_t> find_all(std::span<T const> hay,
+                                  std::span<std::size_t> out) const {
+    std::size_t filled { 0U };
+    if (!out.empty()) {
+      scan(hay, [&](std::size_t const pos) {
+        out[filled++] = pos;
+        return filled != out.size();
+      });
+    }
+    return out.first(filled);
+  }
+
+  [[nodiscard]]
+  std::size_t count(std::span<T const> hay) const {
+    std::size_t matches { 0U };
+    scan(hay, [&matches](std::size_t) {
+      ++matches;
+      return true;
+    });
+    return matches;
+  }
+
+private:
+  enum class strategy { empty, element, first_last, two_way, generic, };
+
+  static bool constexpr vectorizable {
+    detail::is_bitwise_comparable_v<value_type>
+    && (sizeof(value_type) == 1U || sizeof(value_type) == 2U
+        || sizeof(value_type) == 4U || sizeof(value_type) == 8U) };
+
+  //  Hand every match offset to `on_match`, stopping when it returns false.
+  template<class Fn>
+  void scan(std::span<T const> hay, Fn && on_match) const {
+    if (strategy_ == strategy::empty) {
+      for (std::size_t pos { 0U }; pos <= hay.size(); ++pos) {
+        if (!on_match(pos)) {
+          return;
+        }
+      }
+      return;
+    }
+    if (needle_.size() > hay.size()) {
+      return;
+    }
+    if constexpr (vectorizable) {
+      if (strategy_ == strategy::two_way) {
+        two_way_.scan(hay, needle_, &skip_, on_match);
+        return;
+      }
+    }
+
+    auto const last = hay.size() - needle_.size();
+    for (std::size_t pos { 0U }; pos <= last; ++pos) {
+      auto const rest = hay.subspan(pos);
+      auto at { rest.size() };
+      if constexpr (vectorizable) {
+        if (strategy_ == strategy::element) {
+          at = detail::find_element(rest, needle_.front());
+        }
+        else if (strategy_ == strategy::first_last) {
+          at = detail::find_first_last(rest, needle_, pattern_);
+        }
+        else {
+          at = detail::find_scalar(rest, needle_);
+        }
+      }
+      else {
+        at = detail::find_scalar(rest, needle_);
+      }
+      if (at == rest.size() || !on_match(pos + at)) {
+        return;
+      }
+      pos += at;
+    }
+  }
+
+  std::span<T const> needle_;
+  strategy strategy_ { strategy::generic };
+  detail::broadcast_pattern pattern_ {};
+  detail::two_way<T> two_way_ {};
+  detail::skip_table skip_ {};
+};
+
+namespace detail {
+
+//  MARK: find()
+//  Position of the first occurrence of `needle` in `hay`, hay.size() if none.
+//  An empty needle is found at 0 (std::search semantics).
+template<class T>
+[[nodiscard]]
+constexpr std::size_t find(std::span<T const> hay, std::span<T const> needle) {
+  if (std::is_constant_evaluated()) {
+    return find_scalar(hay, needle);
+  }
+  if (needle.empty()) {
+    return 0U;
+  }
+  auto const found = searcher<T> { needle }.find_first(hay);
+  return found == searcher<T>::npos ? hay.size() : found;
+}
+
+} /* namespace detail */
+} /* namespace cspan */
+
+#endif /* cspan_search_hpp */
@@ -0,0 +1,323 @@
+//
+//  cspan_soa.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.wikipedia.org/wiki/AoS_and_SoA
+//  @see: https://en.cppreference.com/w/cpp/utility/apply
+//
+
+#ifndef cspan_soa_hpp
+#define cspan_soa_hpp
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: soa_rows
+ *  The zipped row view of a soa: iterating yields std::tuple<T &...>,
+ *  one reference per column, so
+ *    for (auto [x, y, id] : points.rows()) { ... }
+ *  reads and writes the columns in place.
+ */
+template<class... T>
+class soa_rows {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::tuple<std::remove_cv_t<T>...>;
+    using reference = std::tuple<T &...>;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    iterator(std::tuple<T *...> const columns, std::size_t const ix) noexcept
+      : columns_ { columns }, ix_ { ix } {}
+
+    [[nodiscard]]
+    reference operator*() const noexcept {
+      return std::apply([this](T * const... column) { return reference { column[ix_]... }; }, columns_);
+    }
+
+    iterator & operator++() noexcept { ++ix_; return *this; }
+    iterator operator++(int) noexcept { auto const was = *this; ++ix_; return was; }
+
+    [[nodiscard]]
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept { return lhs.ix_ == rhs.ix_; }
+
+  private:
+    std::tuple<T *...> columns_ {};
+    std::size_t ix_ { 0U };
+  };
+
+  soa_rows(std::tuple<T *...> const columns, std::size_t const size) noexcept
+    : columns_ { columns }, size_ { size } {}
+
+  [[nodiscard]]
+  iterator begin() const noexcept { return { columns_, 0U }; }
+
+  [[nodiscard]]
+  iterator end() const noexcept { return { columns_, size_ }; }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return size_; }
+
+private:
+  std::tuple<T *...> columns_;
+  std::size_t size_;
+};
+
+/*
+ *  MARK: soa
+ *  A growable structure-of-arrays: each of Fields... is stored as its own
+ *  contiguous, cache-line-aligned column in one allocation, and column<I>()
+ *  is a plain std::span over it, so a scan of one field reads only that
+ *  field's bytes and vectorises like a loop over an array. Fields must be
+ *  trivially copyable (columns move with memcpy when the soa grows).
+ */
+template<class... Fields>
+class soa {
+  static_assert(sizeof...(Fields) != 0U, "soa needs at least one field");
+  static_assert((std::is_trivially_copyable_v<Fields> && ...), "soa fields must be trivially copyable");
+  static_assert((!std::is_const_v<Fields> && ...), "soa fields must not be const");
+
+  static std::size_t constexpr column_count { sizeof...(Fields) };
+
+public:
+  template<std::size_t I>
+  using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  static std::size_t constexpr column_align { 64U };
+
+  soa() noexcept = default;
+
+  explicit soa(std::size_t const size) { resize(size); }
+
+  soa(soa const & other) : soa() {
+    reserve(other.size_);
+    size_ = other.size_;
+    for_each_column([&other, this]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      if (size_ != 0U) {
+        std::memcpy(std::get<I>(columns_), std::get<I>(other.columns_), size_ * sizeof(field_type<I>));
+      }
+    });
+  }
+
+  soa(soa && other) noexcept
+    : block_ { std::exchange(other.block_, nullptr) },
+      columns_ { std::exchange(other.columns_, {}) },
+      size_ { std::exchange(other.size_, 0U) },
+      capacity_ { std::exchange(other.capacity_, 0U) } {}
+
+  soa & operator=(soa other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~soa() { deallocate(block_); }
+
+  void swap(soa & other) noexcept {
+    std::swap(block_, other.block_);
+    std::swap(columns_, other.columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return size_ == 0U; }
+
+  [[nodiscard]]
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  void reserve(std::size_t const capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    auto const block = allocate(capacity);
+    auto const columns = layout(block, capacity);
+    for_each_column([&columns, this]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      if (size_ != 0U) {
+        std::memcpy(std::get<I>(columns), std::get<I>(columns_), size_ * sizeof(field_type<I>));
+      }
+    });
+    deallocate(block_);
+    block_ = block;
+    columns_ = columns;
+    capacity_ = capacity;
+  }
+
+  //  New rows are value-initialised.
+  void resize(std::size_t const size) {
+    reserve(size);
+    if (size > size_) {
+      for_each_column([size, this]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+        std::fill(std::get<I>(columns_) + size_, std::get<I>(columns_) + size, field_type<I> {});
+      });
+    }
+    size_ = size;
+  }
+
+  void clear() noexcept { size_ = 0U; }
+
+  //  `fields` may refer to this soa's own rows.
+  void push_back(Fields const &... fields) {
+    if (size_ == capacity_) {
+      //  Copy them before reserve() frees the block they live in.
+      std::tuple<Fields...> const row { fields... };
+      reserve(std::max<std::size_t>(16U, capacity_ * 2U));
+      std::apply([this](Fields const &... copy) { store(copy...); }, row);
+    }
+    else {
+      store(fields...);
+    }
+    ++size_;
+  }
+
+  //  Column I: contiguous, aligned to column_align.
+  template<std::size_t I>
+  [[nodiscard]]
+  std::span<field_type<I>> column() noexcept { return { std::get<I>(columns_), size_ }; }
+
+  template<std::size_t I>
+  [[nodiscard]]
+  std::span<field_type<I> const> column() const noexcept { return { std::get<I>(columns_), size_ }; }
+
+  //  Every column at once, for structured bindings.
+  [[nodiscard]]
+  std::tuple<std::span<Fields>...> columns() noexcept {
+    return std::apply([this](Fields * const... column) {
+      return std::tuple<std::span<Fields>...> { std::span<Fields> { column, size_ }... };
+    }, columns_);
+  }
+
+  [[nodiscard]]
+  std::tuple<std::span<Fields const>...> columns() const noexcept {
+    return std::apply([this](Fields * const... column) {
+      return std::tuple<std::span<Fields const>...> { std::span<Fields const> { column, size_ }... };
+    }, columns_);
+  }
+
+  //  Row `ix` as references into the columns.
+  [[nodiscard]]
+  std::tuple<Fields &...> row(std::size_t const ix) noexcept {
+    assert(ix < size_);
+    return std::apply([ix](Fields * const... column) { return std::tuple<Fields &...> { column[ix]... }; }, columns_);
+  }
+
+  [[nodiscard]]
+  std::tuple<Fields const &...> row(std::size_t const ix) const noexcept {
+    assert(ix < size_);
+    return std::apply([ix](Fields * const... column) {
+      return std::tuple<Fields const &...> { column[ix]... };
+    }, columns_);
+  }
+
+  [[nodiscard]]
+  soa_rows<Fields...> rows() noexcept { return { columns_, size_ }; }
+
+  [[nodiscard]]
+  soa_rows<Fields const...> rows() const noexcept {
+    return { std::apply([](Fields * const... column) {
+      return std::tuple<Fields const *...> { column... };
+    }, columns_), size_ };
+  }
+
+private:
+  void store(Fields const &... fields) noexcept {
+    std::apply([this, &fields...](Fields * const... column) { ((column[size_] = fields), ...); }, columns_);
+  }
+
+  template<class Fn>
+  static void for_each_column(Fn && fn) {
+    [&fn]<std::size_t... I>(std::index_sequence<I...>) {
+      (fn(std::integral_constant<std::size_t, I> {}), ...);
+    }(std::make_index_sequence<column_count> {});
+  }
+
+  //  Byte offset of each column in a block for `capacity` rows.
+  [[nodiscard]]
+  static std::array<std::size_t, column_count + 1U> offsets(std::size_t const capacity) noexcept {
+    std::array<std::size_t, column_count + 1U> at {};
+    std::size_t const sizes[] { sizeof(Fields)... };
+    for (std::size_t ix { 0U }; ix != column_count; ++ix) {
+      auto const end = at[ix] + capacity * sizes[ix];
+      at[ix + 1U] = (end + column_align - 1U) / column_align * column_align;
+    }
+    return at;
+  }
+
+  [[nodiscard]]
+  static std::byte * allocate(std::size_t const capacity) {
+    return static_cast<std::byte *>(::operator new(offsets(capacity).back(), std::align_val_t { column_align }));
+  }
+
+  static void deallocate(std::byte * const block) noexcept {
+    if (block != nullptr) {
+      ::operator delete(block, std::align_val_t { column_align });
+    }
+  }
+
+  [[nodiscard]]
+  static std::tuple<Fields *...> layout(std::byte * const block, std::size_t const capacity) noexcept {
+    auto const at = offsets(capacity);
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return std::tuple<Fields *...> { reinterpret_cast<Fields *>(block + at[I])... };
+    }(std::make_index_sequence<column_count> {});
+  }
+
+  std::byte * block_ { nullptr };
+  std::tuple<Fields *...> columns_ {};
+  std::size_t size_ { 0U };
+  std::size_t capacity_ { 0U };
+};
+
+/*
+ *  MARK: aos_to_soa(), soa_to_aos()
+ *  Convert between an array of structs and a soa, one member pointer per
+ *  column in column order:
+ *    aos_to_soa(std::span { particles }, columns, &particle::x, &particle::mass);
+ *  aos_to_soa replaces the soa's contents; soa_to_aos writes dst, which
+ *  must be at least src.size() long.
+ */
+template<class R, std::size_t N, class... Fields>
+void aos_to_soa(std::span<R, N> const src, soa<Fields...> & dst, Fields std::remove_cv_t<R>::*... members) {
+  dst.clear();
+  dst.resize(src.size());
+  auto const columns = dst.columns();
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    for (std::size_t ix { 0U }; ix != src.size(); ++ix) {
+      ((std::get<I>(columns)[ix] = src[ix].*members), ...);
+    }
+  }(std::index_sequence_for<Fields...> {});
+}
+
+template<class R, std::size_t N, class... Fields>
+void soa_to_aos(soa<Fields...> const & src, std::span<R, N> const dst, Fields R::*... members) {
+  assert(dst.size() >= src.size());
+  auto const columns = src.columns();
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    for (std::size_t ix { 0U }; ix != src.size(); ++ix) {
+      ((dst[ix].*members = std::get<I>(columns)[ix]), ...);
+    }
+  }(std::index_sequence_for<Fields...> {});
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_soa_hpp */
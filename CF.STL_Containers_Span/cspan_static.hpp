@@ -0,0 +1,324 @@
+//
+//  cspan_static.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://cmph.sourceforge.net/papers/esa09.pdf
+//  @see: https://en.cppreference.com/w/cpp/language/constexpr
+//  @see: https://probablydance.com/2023/04/27/beautiful-branchless-binary-search/
+//
+
+#ifndef cspan_static_hpp
+#define cspan_static_hpp
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+//  MARK: - namespace cspan::detail
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+//  Not constexpr on purpose: reached while building a table in a constant
+//  expression, it makes that expression ill-formed (a compile error that
+//  points here); at run time it throws.
+[[noreturn]]
+inline void invalid_table(char const * const what) {
+  throw std::system_error { std::make_error_code(std::errc::invalid_argument), what };
+}
+
+//  splitmix64 finaliser.
+[[nodiscard]]
+constexpr std::uint64_t mix(std::uint64_t value) noexcept {
+  value ^= value >> 30U;
+  value *= 0xBF58'476D'1CE4'E5B9ULL;
+  value ^= value >> 27U;
+  value *= 0x94D0'49BB'1331'11EBULL;
+  return value ^ (value >> 31U);
+}
+
+} /* namespace detail */
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+//  Everything below is constexpr, so tables of constant data can be built
+//  into the binary: no static initialiser, no first-use cost.
+//    static constexpr std::string_view raw[] { ... };
+//    static constexpr cspan::perfect_hash lookup { std::span { raw } };
+
+/*
+ *  MARK: static_hash
+ *  The seeded, constexpr hash the tables use: integers and enums are
+ *  mixed directly, anything convertible to std::string_view is hashed by
+ *  character (FNV-1a, then mixed). Specialise for other key types.
+ */
+template<class K>
+struct static_hash {
+  [[nodiscard]]
+  constexpr std::uint64_t operator()(K const & key, std::uint64_t const seed) const noexcept {
+    if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+      return detail::mix(static_cast<std::uint64_t>(key) + seed * 0x9E37'79B9'7F4A'7C15ULL);
+    }
+    else {
+      static_assert(std::is_convertible_v<K const &, std::string_view>, "static_hash: no hash for this key type");
+      auto hash { 0xCBF2'9CE4'8422'2325ULL ^ seed };
+      for (auto const ch : std::string_view { key }) {
+        hash = (hash ^ static_cast<unsigned char>(ch)) * 0x0000'0100'0000'01B3ULL;
+      }
+      return detail::mix(hash);
+    }
+  }
+};
+
+//  MARK: sorted()
+//  A sorted copy of `values`, with the extent kept.
+template<class T, std::size_t N, class Compare = std::less<>>
+  requires (N != std::dynamic_extent)
+[[nodiscard]]
+constexpr auto sorted(std::span<T, N> values, Compare comp = {}) {
+  std::array<std::remove_cv_t<T>, N> out {};
+  std::copy(values.begin(), values.end(), out.begin());
+  std::sort(out.begin(), out.end(), comp);
+  return out;
+}
+
+//  MARK: unique()
+//  Move the first of each run of equal elements to the front of `span`;
+//  returns how many there are (sort first for set semantics).
+template<class T, std::size_t N, class Equal = std::equal_to<>>
+[[nodiscard]]
+constexpr std::size_t unique(std::span<T, N> span, Equal eq = {}) {
+  return static_cast<std::size_t>(std::unique(span.begin(), span.end(), eq) - span.begin());
+}
+
+//  MARK: lower_bound()
+//  Index of the first element of sorted `span` not less than `value`.
+//  Arithmetic elements are searched branch-free: the loop only picks the
+//  next base, a conditional move, with a trip count fixed by the size.
+//  Other elements branch inside their compare anyway; std::lower_bound.
+template<class T, std::size_t N, class U, class Compare = std::less<>>
+[[nodiscard]]
+constexpr std::size_t lower_bound(std::span<T, N> span, U const & value, Compare comp = {}) {
+  if constexpr (std::is_arithmetic_v<std::remove_cv_t<T>>) {
+    auto size = span.size();
+    if (size == 0U) {
+      return 0U;
+    }
+    std::size_t base { 0U };
+    while (size > 1U) {
+      auto const half = size / 2U;
+      base = comp(span[base + half], value) ? base + half : base;
+      size -= half;
+    }
+    return base + static_cast<std::size_t>(comp(span[base], value));
+  }
+  else {
+    return static_cast<std::size_t>(std::lower_bound(span.begin(), span.end(), value, comp) - span.begin());
+  }
+}
+
+//  MARK: binary_search()
+template<class T, std::size_t N, class U, class Compare = std::less<>>
+[[nodiscard]]
+constexpr bool binary_search(std::span<T, N> span, U const & value, Compare comp = {}) {
+  auto const ix = lower_bound(span, value, comp);
+  return ix != span.size() && !comp(value, span[ix]);
+}
+
+/*
+ *  MARK: static_set
+ *  Up to N values, sorted and without duplicates, searched by
+ *  lower_bound. Build it from constant data:
+ *    static constexpr cspan::static_set set { std::span { raw } };
+ */
+template<class T, std::size_t N, class Compare = std::less<>>
+class static_set {
+public:
+  using value_type = T;
+
+  constexpr explicit static_set(std::span<T const, N> const values, Compare comp = {})
+    : values_ { sorted(values, comp) },
+      size_ { unique(std::span { values_ }, [comp](T const & lhs, T const & rhs) {
+        return !comp(lhs, rhs) && !comp(rhs, lhs);
+      }) },
+      comp_ { comp } {}
+
+  [[nodiscard]]
+  constexpr std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]]
+  constexpr std::span<T const> values() const noexcept { return { values_.data(), size_ }; }
+
+  [[nodiscard]]
+  constexpr T const * begin() const noexcept { return values_.data(); }
+
+  [[nodiscard]]
+  constexpr T const * end() const noexcept { return values_.data() + size_; }
+
+  [[nodiscard]]
+  constexpr T const & operator[](std::size_t const ix) const noexcept { return values_[ix]; }
+
+  //  Rank of `value`, or size() if absent.
+  template<class U>
+  [[nodiscard]]
+  constexpr std::size_t find(U const & value) const {
+    auto const ix = cspan::lower_bound(values(), value, comp_);
+    return ix != size_ && !comp_(value, values_[ix]) ? ix : size_;
+  }
+
+  template<class U>
+  [[nodiscard]]
+  constexpr bool contains(U const & value) const { return find(value) != size_; }
+
+private:
+  std::array<T, N> values_;
+  std::size_t size_;
+  [[no_unique_address]] Compare comp_;
+};
+
+template<class T, std::size_t N>
+static_set(std::span<T, N>) -> static_set<std::remove_cv_t<T>, N>;
+
+/*
+ *  MARK: perfect_hash
+ *  A collision-free hash table over N distinct keys, built by
+ *  hash-and-displace (CHD): keys are hashed into N / 2 buckets, and the
+ *  buckets, largest first, each search for a displacement that sends all
+ *  their keys to free slots of a power-of-two table. A lookup is one hash,
+ *  one displacement load and one key compare.
+ *  find() returns the key's index in the array it was built from (so a
+ *  parallel array of values makes it a map), or npos.
+ *  Duplicate keys are an error: a compile error when built constexpr.
+ */
+template<class K, std::size_t N, class Hash = static_hash<K>>
+class perfect_hash {
+  static_assert(N != 0U && N != std::dynamic_extent, "perfect_hash needs a fixed, non-empty key set");
+
+public:
+  using key_type = K;
+
+  static std::size_t constexpr npos { static_cast<std::size_t>(-1) };
+  static std::size_t constexpr slot_count { std::bit_ceil(N) };
+  static std::size_t constexpr bucket_count { (N + 1U) / 2U };
+
+  constexpr explicit perfect_hash(std::span<K const, N> const keys, Hash hash = {})
+    : hash_ { hash } {
+    //  A fresh seed reshuffles every bucket; a handful always suffices
+    //  for distinct keys.
+    for (seed_ = 0U; !build(keys); ++seed_) {
+      if (seed_ == 64U) {
+        detail::invalid_table("perfect_hash: no displacement found");
+      }
+    }
+  }
+
+  [[nodiscard]]
+  static constexpr std::size_t size() noexcept { return N; }
+
+  template<class U>
+  [[nodiscard]]
+  constexpr std::size_t find(U const & key) const {
+    auto const hash = hash_(key, seed_);
+    auto const slot = place(hash, displacement_[bucket(hash)]);
+    return index_[slot] != npos && keys_[slot] == key ? index_[slot] : npos;
+  }
+
+  template<class U>
+  [[nodiscard]]
+  constexpr bool contains(U const & key) const { return find(key) != npos; }
+
+private:
+  [[nodiscard]]
+  static constexpr std::size_t bucket(std::uint64_t const hash) noexcept {
+    return static_cast<std::size_t>(hash >> 32U) % bucket_count;
+  }
+
+  [[nodiscard]]
+  static constexpr std::size_t place(std::uint64_t const hash, std::uint32_t const displacement) noexcept {
+    return static_cast<std::size_t>(detail::mix(hash + displacement)) & (slot_count - 1U);
+  }
+
+  //  One attempt with seed_; false if some bucket could not be placed.
+  constexpr bool build(std::span<K const, N> const keys) {
+    std::array<std::uint64_t, N> hashes {};
+    std::array<std::size_t, bucket_count + 1U> first {};
+    for (std::size_t ix { 0U }; ix != N; ++ix) {
+      hashes[ix] = hash_(keys[ix], seed_);
+      ++first[bucket(hashes[ix]) + 1U];
+    }
+    //  Keys grouped by bucket (a counting sort): bucket b holds
+    //  members[first[b] .. first[b + 1]).
+    std::size_t largest { 0U };
+    for (std::size_t b { 0U }; b != bucket_count; ++b) {
+      largest = std::max(largest, first[b + 1U]);
+      first[b + 1U] += first[b];
+    }
+    std::array<std::size_t, N> members {};
+    auto fill = first;
+    for (std::size_t ix { 0U }; ix != N; ++ix) {
+      members[fill[bucket(hashes[ix])]++] = ix;
+    }
+    for (std::size_t b { 0U }; b != bucket_count; ++b) {
+      for (auto at = first[b]; at != first[b + 1U]; ++at) {
+        for (auto other = at + 1U; other != first[b + 1U]; ++other) {
+          if (keys[members[at]] == keys[members[other]]) {
+            detail::invalid_table("perfect_hash: duplicate key");
+          }
+        }
+      }
+    }
+
+    index_.fill(npos);
+    displacement_.fill(0U);
+    std::array<std::size_t, N> slots {};
+    for (auto count = largest; count != 0U; --count) {
+      for (std::size_t b { 0U }; b != bucket_count; ++b) {
+        if (first[b + 1U] - first[b] != count) {
+          continue;
+        }
+        auto placed { false };
+        for (std::uint32_t displacement { 0U }; !placed && displacement != 16U * slot_count; ++displacement) {
+          placed = true;
+          for (std::size_t at { 0U }; placed && at != count; ++at) {
+            slots[at] = place(hashes[members[first[b] + at]], displacement);
+            placed = index_[slots[at]] == npos
+                     && std::find(slots.begin(), slots.begin() + at, slots[at]) == slots.begin() + at;
+          }
+          if (placed) {
+            displacement_[b] = displacement;
+          }
+        }
+        if (!placed) {
+          return false;
+        }
+        for (std::size_t at { 0U }; at != count; ++at) {
+          auto const key = members[first[b] + at];
+          keys_[slots[at]] = keys[key];
+          index_[slots[at]] = key;
+        }
+      }
+    }
+    return true;
+  }
+
+  std::array<K, slot_count> keys_ {};
+  std::array<std::size_t, slot_count> index_ {};
+  std::array<std::uint32_t, bucket_count> displacement_ {};
+  std::uint64_t seed_ { 0U };
+  [[no_unique_address]] Hash hash_;
+};
+
+template<class K, std::size_t N>
+perfect_hash(std::span<K, N>) -> perfect_hash<std::remove_cv_t<K>, N>;
+
+} /* namespace cspan */
+
+#endif /* cspan_static_hpp */
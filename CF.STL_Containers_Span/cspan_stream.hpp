@@ -0,0 +1,267 @@
+//
+//  cspan_stream.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://man7.org/linux/man-pages/man2/read.2.html
+//  @see: https://en.cppreference.com/w/cpp/thread/condition_variable
+//  @see: https://man7.org/linux/man-pages/man2/poll.2.html
+//
+
+#ifndef cspan_stream_hpp
+#define cspan_stream_hpp
+
+#if (__has_include(<unistd.h>))
+#define CSPAN_HAS_STREAM_READER 1
+#else
+#define CSPAN_HAS_STREAM_READER 0
+#endif  /* (__has_include(<unistd.h>)) */
+
+#if (CSPAN_HAS_STREAM_READER)
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+struct stream_options {
+  //  New bytes per chunk (the last chunk may be shorter).
+  std::size_t chunk_size { 1U << 20U };
+  //  Trailing bytes of each chunk repeated at the head of the next. For a
+  //  search of an L-byte needle use L - 1: every match then lies wholly
+  //  inside exactly one chunk.
+  std::size_t overlap { 0U };
+  //  Read the next chunk on a background thread while the current one is
+  //  processed.
+  bool prefetch { true };
+};
+
+/*
+ *  MARK: stream_reader
+ *  Reads a file descriptor (file, pipe, stdin) as a sequence of chunks in
+ *  two page-aligned buffers. With prefetch, a worker thread fills one
+ *  buffer while the caller holds the chunk in the other; a chunk stays
+ *  valid until the next call to next(). The descriptor is not owned.
+ *  Read errors throw std::system_error from next().
+ *  The worker waits for input in poll() beside a self-pipe, so a reader
+ *  dropped early (say once a match is found) does not hang on a pipe or
+ *  terminal that has nothing more to send.
+ */
+class stream_reader {
+public:
+  explicit stream_reader(int const fd, stream_options const & options = {})
+    : fd_ { fd }, chunk_ { options.chunk_size }, overlap_ { options.overlap } {
+    assert(chunk_ != 0U);
+    auto const pages = (overlap_ + chunk_ + page_size - 1U) / page_size;
+    for (auto & buffer : buffers_) {
+      buffer.reset(new page[pages]);
+    }
+    if (options.prefetch) {
+      if (::pipe(cancel_) != 0) {
+        throw std::system_error { errno, std::generic_category(), "stream_reader pipe" };
+      }
+      try {
+        worker_ = std::thread { [this] { work(); } };
+      }
+      catch (...) {
+        //  No destructor runs for a half-built reader.
+        ::close(cancel_[0]);
+        ::close(cancel_[1]);
+        throw;
+      }
+    }
+    request(0U);
+  }
+
+  stream_reader(stream_reader const &) = delete;
+  stream_reader & operator=(stream_reader const &) = delete;
+
+  ~stream_reader() {
+    if (worker_.joinable()) {
+      {
+        std::lock_guard lock { mutex_ };
+        stop_ = true;
+      }
+      wake_.notify_all();
+      //  Interrupt a read blocked on a quiet pipe.
+      std::byte const wake { 1 };
+      while (::write(cancel_[1], &wake, 1U) < 0 && errno == EINTR) {}
+      worker_.join();
+      ::close(cancel_[0]);
+      ::close(cancel_[1]);
+    }
+  }
+
+  //  The next chunk: up to `overlap` bytes carried over from the previous
+  //  chunk, then up to chunk_size new bytes. Empty at end of stream.
+  [[nodiscard]]
+  std::span<std::byte const> next() {
+    if (eof_) {
+      return {};
+    }
+    auto const filled = collect(front_);
+    if (filled == 0U) {
+      eof_ = true;
+      return {};
+    }
+
+    //  Carry the tail of the previous chunk (still in the other buffer)
+    //  in front of the new bytes; after that the other buffer is free.
+    auto const back = 1U - front_;
+    auto const carry = std::min(overlap_, last_carry_ + last_fresh_);
+    auto const buffer = data(front_);
+    std::memcpy(buffer + overlap_ - carry, data(back) + overlap_ + last_fresh_ - carry, carry);
+    if (filled == chunk_) {
+      request(back);
+    }
+    else {
+      eof_ = true;
+    }
+
+    stream_offset_ = consumed_ - carry;
+    consumed_ += filled;
+    last_fresh_ = filled;
+    last_carry_ = carry;
+    front_ = back;
+    return { buffer + overlap_ - carry, carry + filled };
+  }
+
+  //  Stream position of the first byte of the chunk last returned.
+  [[nodiscard]]
+  std::size_t offset() const noexcept { return stream_offset_; }
+
+private:
+  static std::size_t constexpr page_size { 4'096U };
+
+  struct alignas(page_size) page {
+    std::byte bytes[page_size];
+  };
+
+  [[nodiscard]]
+  std::byte * data(std::size_t const ix) const noexcept {
+    return buffers_[ix][0].bytes;
+  }
+
+  //  Fill buffer `ix` (after the overlap area) with up to chunk_ bytes.
+  //  Short reads from pipes are retried until the chunk is full or EOF,
+  //  or, with a worker, until the cancel pipe turns readable.
+  std::size_t fill(std::size_t const ix, int & error) const {
+    auto const dst = data(ix) + overlap_;
+    std::size_t done { 0U };
+    while (done != chunk_) {
+      if (cancel_[0] >= 0) {
+        pollfd ready[2] { { fd_, POLLIN, 0 }, { cancel_[0], POLLIN, 0 }, };
+        if (::poll(ready, 2U, -1) < 0) {
+          if (errno != EINTR) {
+            error = errno;
+            break;
+          }
+          continue;
+        }
+        if (ready[1].revents != 0) {
+          break;
+        }
+      }
+      auto const got = ::read(fd_, dst + done, chunk_ - done);
+      if (got > 0) {
+        done += static_cast<std::size_t>(got);
+      }
+      else if (got == 0) {
+        break;
+      }
+      else if (errno != EINTR) {
+        error = errno;
+        break;
+      }
+    }
+    return done;
+  }
+
+  //  Start filling buffer `ix`: hand it to the worker, or read it now.
+  void request(std::size_t const ix) {
+    if (!worker_.joinable()) {
+      filled_[ix] = fill(ix, error_);
+      ready_[ix] = true;
+      return;
+    }
+    {
+      std::lock_guard lock { mutex_ };
+      ready_[ix] = false;
+      pending_[ix] = true;
+    }
+    wake_.notify_all();
+  }
+
+  //  Wait until buffer `ix` is filled; returns its new byte count.
+  std::size_t collect(std::size_t const ix) {
+    std::unique_lock lock { mutex_ };
+    done_.wait(lock, [this, ix] { return ready_[ix]; });
+    if (error_ != 0) {
+      throw std::system_error { error_, std::generic_category(), "stream_reader read" };
+    }
+    return filled_[ix];
+  }
+
+  void work() {
+    std::unique_lock lock { mutex_ };
+    for (;;) {
+      wake_.wait(lock, [this] { return stop_ || pending_[0] || pending_[1]; });
+      if (stop_) {
+        return;
+      }
+      auto const ix = pending_[0] ? 0U : 1U;
+      pending_[ix] = false;
+      lock.unlock();
+      int error { 0 };
+      auto const filled = fill(ix, error);
+      lock.lock();
+      filled_[ix] = filled;
+      error_ = error_ != 0 ? error_ : error;
+      ready_[ix] = true;
+      done_.notify_all();
+    }
+  }
+
+  int fd_;
+  std::size_t chunk_;
+  std::size_t overlap_;
+  std::unique_ptr<page[]> buffers_[2];
+
+  std::size_t front_ { 0U };
+  std::size_t last_fresh_ { 0U };
+  std::size_t last_carry_ { 0U };
+  std::size_t consumed_ { 0U };
+  std::size_t stream_offset_ { 0U };
+  bool eof_ { false };
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  //  Self-pipe: the destructor writes to [1] to stop a waiting worker.
+  int cancel_[2] { -1, -1 };
+  std::thread worker_;
+  bool pending_[2] { false, false };
+  bool ready_[2] { false, false };
+  std::size_t filled_[2] { 0U, 0U };
+  int error_ { 0 };
+  bool stop_ { false };
+};
+
+} /* namespace cspan */
+
+#endif  /* (CSPAN_HAS_STREAM_READER) */
+
+#endif /* cspan_stream_hpp */
@@ -0,0 +1,337 @@
+//
+//  cspan_strided.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/container/mdspan
+//  @see: https://en.cppreference.com/w/cpp/container/mdspan/layout_stride
+//  @see: https://en.wikipedia.org/wiki/Loop_nest_optimization
+//
+
+#ifndef cspan_strided_hpp
+#define cspan_strided_hpp
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include "cspan_algorithm.hpp"
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+/*
+ *  MARK: strided_span
+ *  `size` elements of T, `stride` elements apart: element ix is
+ *  data[ix * stride]. A row or column of a span2d, every n-th sample of
+ *  a signal, one channel of interleaved data. Non-owning, like std::span.
+ */
+template<class T>
+class strided_span {
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+
+  class iterator {
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    iterator() noexcept = default;
+    iterator(T * const base, std::size_t const stride, std::size_t const ix) noexcept
+      : base_ { base }, stride_ { stride }, ix_ { static_cast<difference_type>(ix) } {}
+
+    [[nodiscard]]
+    T & operator*() const noexcept { return base_[static_cast<std::size_t>(ix_) * stride_]; }
+    [[nodiscard]]
+    T * operator->() const noexcept { return &**this; }
+    [[nodiscard]]
+    T & operator[](difference_type const off) const noexcept { return *(*this + off); }
+
+    iterator & operator++() noexcept { ++ix_; return *this; }
+    iterator operator++(int) noexcept { auto const was = *this; ++ix_; return was; }
+    iterator & operator--() noexcept { --ix_; return *this; }
+    iterator operator--(int) noexcept { auto const was = *this; --ix_; return was; }
+    iterator & operator+=(difference_type const off) noexcept { ix_ += off; return *this; }
+    iterator & operator-=(difference_type const off) noexcept { ix_ -= off; return *this; }
+
+    [[nodiscard]]
+    friend iterator operator+(iterator it, difference_type const off) noexcept { return it += off; }
+    [[nodiscard]]
+    friend iterator operator+(difference_type const off, iterator it) noexcept { return it += off; }
+    [[nodiscard]]
+    friend iterator operator-(iterator it, difference_type const off) noexcept { return it -= off; }
+    [[nodiscard]]
+    friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept {
+      return lhs.ix_ - rhs.ix_;
+    }
+    [[nodiscard]]
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept { return lhs.ix_ == rhs.ix_; }
+    [[nodiscard]]
+    friend auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept { return lhs.ix_ <=> rhs.ix_; }
+
+  private:
+    T * base_ { nullptr };
+    std::size_t stride_ { 1U };
+    difference_type ix_ { 0 };
+  };
+
+  strided_span() noexcept = default;
+
+  strided_span(T * const data, std::size_t const size, std::size_t const stride) noexcept
+    : data_ { data }, size_ { size }, stride_ { stride } {
+    assert(stride != 0U);
+  }
+
+  //  Every `stride`-th element of `span`, starting with the first.
+  template<std::size_t N>
+  explicit strided_span(std::span<T, N> const span, std::size_t const stride = 1U) noexcept
+    : strided_span(span.data(), (span.size() + stride - 1U) / stride, stride) {}
+
+  //  strided_span<T> -> strided_span<T const>.
+  template<class U>
+    requires (std::is_convertible_v<U (*)[], T (*)[]>)
+  strided_span(strided_span<U> const other) noexcept
+    : data_ { other.data() }, size_ { other.size() }, stride_ { other.stride() } {}
+
+  [[nodiscard]]
+  T * data() const noexcept { return data_; }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return size_ == 0U; }
+
+  [[nodiscard]]
+  std::size_t stride() const noexcept { return stride_; }
+
+  [[nodiscard]]
+  T & operator[](std::size_t const ix) const noexcept {
+    assert(ix < size_);
+    return data_[ix * stride_];
+  }
+
+  [[nodiscard]]
+  T & front() const noexcept { return (*this)[0U]; }
+
+  [[nodiscard]]
+  T & back() const noexcept { return (*this)[size_ - 1U]; }
+
+  [[nodiscard]]
+  strided_span subspan(std::size_t const offset, std::size_t count = std::dynamic_extent) const noexcept {
+    assert(offset <= size_);
+    count = std::min(count, size_ - offset);
+    return { data_ + offset * stride_, count, stride_ };
+  }
+
+  [[nodiscard]]
+  iterator begin() const noexcept { return { data_, stride_, 0U }; }
+
+  [[nodiscard]]
+  iterator end() const noexcept { return { data_, stride_, size_ }; }
+
+private:
+  T * data_ { nullptr };
+  std::size_t size_ { 0U };
+  std::size_t stride_ { 1U };
+};
+
+template<class T, std::size_t N>
+strided_span(std::span<T, N>, std::size_t) -> strided_span<T>;
+
+/*
+ *  MARK: span2d
+ *  A rows x cols matrix over flat storage, mdspan's layout_stride in two
+ *  dimensions: element (r, c) is data[r * row_stride + c * col_stride].
+ *  Row-major storage has col_stride 1, column-major has row_stride 1;
+ *  transposed() swaps the two, so it costs nothing. block() is a
+ *  sub-matrix (a tile) over the same storage.
+ */
+template<class T>
+class span2d {
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+
+  span2d() noexcept = default;
+
+  span2d(T * const data, std::size_t const rows, std::size_t const cols,
+         std::size_t const row_stride, std::size_t const col_stride = 1U) noexcept
+    : data_ { data }, rows_ { rows }, cols_ { cols },
+      row_stride_ { row_stride }, col_stride_ { col_stride } {}
+
+  //  `flat` in row-major order: rows * cols elements, no padding.
+  template<std::size_t N>
+  span2d(std::span<T, N> const flat, std::size_t const rows, std::size_t const cols) noexcept
+    : span2d(flat.data(), rows, cols, cols, 1U) {
+    assert(rows * cols <= flat.size());
+  }
+
+  //  span2d<T> -> span2d<T const>.
+  template<class U>
+    requires (std::is_convertible_v<U (*)[], T (*)[]>)
+  span2d(span2d<U> const other) noexcept
+    : span2d(other.data(), other.rows(), other.cols(), other.row_stride(), other.col_stride()) {}
+
+  [[nodiscard]]
+  T * data() const noexcept { return data_; }
+
+  [[nodiscard]]
+  std::size_t rows() const noexcept { return rows_; }
+
+  [[nodiscard]]
+  std::size_t cols() const noexcept { return cols_; }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return rows_ * cols_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return rows_ == 0U || cols_ == 0U; }
+
+  [[nodiscard]]
+  std::size_t row_stride() const noexcept { return row_stride_; }
+
+  [[nodiscard]]
+  std::size_t col_stride() const noexcept { return col_stride_; }
+
+  [[nodiscard]]
+  T & operator()(std::size_t const row, std::size_t const col) const noexcept {
+    assert(row < rows_ && col < cols_);
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+
+  [[nodiscard]]
+  strided_span<T> row(std::size_t const row) const noexcept {
+    assert(row < rows_);
+    return { data_ + row * row_stride_, cols_, col_stride_ };
+  }
+
+  [[nodiscard]]
+  strided_span<T> col(std::size_t const col) const noexcept {
+    assert(col < cols_);
+    return { data_ + col * col_stride_, rows_, row_stride_ };
+  }
+
+  //  Row `row` as a contiguous std::span; needs col_stride() == 1.
+  [[nodiscard]]
+  std::span<T> row_span(std::size_t const row) const noexcept {
+    assert(row < rows_ && col_stride_ == 1U);
+    return { data_ + row * row_stride_, cols_ };
+  }
+
+  //  The rows x cols tile at (row, col), clipped to the matrix.
+  [[nodiscard]]
+  span2d block(std::size_t const row, std::size_t const col,
+               std::size_t const rows, std::size_t const cols) const noexcept {
+    assert(row <= rows_ && col <= cols_);
+    return { data_ + row * row_stride_ + col * col_stride_,
+             std::min(rows, rows_ - row), std::min(cols, cols_ - col), row_stride_, col_stride_ };
+  }
+
+  [[nodiscard]]
+  span2d transposed() const noexcept {
+    return { data_, cols_, rows_, col_stride_, row_stride_ };
+  }
+
+private:
+  T * data_ { nullptr };
+  std::size_t rows_ { 0U };
+  std::size_t cols_ { 0U };
+  std::size_t row_stride_ { 0U };
+  std::size_t col_stride_ { 1U };
+};
+
+template<class T, std::size_t N>
+span2d(std::span<T, N>, std::size_t, std::size_t) -> span2d<T>;
+
+//  MARK: for_each_tile()
+//  fn(tile, row, col) for each tile_rows x tile_cols block of `view` in
+//  row-major tile order; edge tiles are smaller.
+template<class T, class Fn>
+void for_each_tile(span2d<T> const view, std::size_t const tile_rows, std::size_t const tile_cols, Fn && fn) {
+  assert(tile_rows != 0U && tile_cols != 0U);
+  for (std::size_t row { 0U }; row < view.rows(); row += tile_rows) {
+    for (std::size_t col { 0U }; col < view.cols(); col += tile_cols) {
+      fn(view.block(row, col, tile_rows, tile_cols), row, col);
+    }
+  }
+}
+
+namespace detail {
+
+//  Edge of the square tiles used by copy() / transpose(): at most 64,
+//  halved until a source and a destination tile fit in 32 KiB of L1
+//  together (64 x 64 for 4-byte elements, 32 x 32 for 8-byte).
+template<class T>
+[[nodiscard]]
+constexpr std::size_t tile_edge() noexcept {
+  std::size_t edge { 64U };
+  while (edge > 8U && 2U * edge * edge * sizeof(T) > (32U << 10U)) {
+    edge /= 2U;
+  }
+  return edge;
+}
+
+} /* namespace detail */
+
+/*
+ *  MARK: copy() (span2d)
+ *  dst = src element-wise; the shapes must match. When both sides have
+ *  contiguous rows (or both contiguous columns) this is one cspan::copy
+ *  per row. Otherwise the elements go tile by tile, so both sides'
+ *  cache lines are reused before they are evicted, where a plain row
+ *  loop strides through the other side a whole line per element.
+ */
+template<class T, class U>
+span2d<U> copy(span2d<T> const src, span2d<U> const dst) {
+  static_assert(std::is_same_v<std::remove_cv_t<T>, U>, "copy: element types differ");
+  assert(src.rows() == dst.rows() && src.cols() == dst.cols());
+  if (src.col_stride() == 1U && dst.col_stride() == 1U) {
+    for (std::size_t row { 0U }; row != src.rows(); ++row) {
+      cspan::copy(src.row_span(row), dst.row_span(row));
+    }
+    return dst;
+  }
+  if (src.row_stride() == 1U && dst.row_stride() == 1U) {
+    cspan::copy(src.transposed(), dst.transposed());
+    return dst;
+  }
+
+  auto constexpr edge = detail::tile_edge<U>();
+  for (std::size_t row0 { 0U }; row0 < src.rows(); row0 += edge) {
+    auto const row1 = std::min(row0 + edge, src.rows());
+    for (std::size_t col0 { 0U }; col0 < src.cols(); col0 += edge) {
+      auto const col1 = std::min(col0 + edge, src.cols());
+      for (auto row = row0; row != row1; ++row) {
+        auto const from = src.data() + row * src.row_stride();
+        auto const to = dst.data() + row * dst.row_stride();
+        for (auto col = col0; col != col1; ++col) {
+          to[col * dst.col_stride()] = from[col * src.col_stride()];
+        }
+      }
+    }
+  }
+  return dst;
+}
+
+//  MARK: transpose()
+//  dst = src transposed (dst is src.cols() x src.rows()), cache-blocked.
+template<class T, class U>
+span2d<U> transpose(span2d<T> const src, span2d<U> const dst) {
+  return cspan::copy(src.transposed(), dst);
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_strided_hpp */
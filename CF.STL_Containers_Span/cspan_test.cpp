@@ -0,0 +1,1549 @@
+//
+//  cspan_test.cpp
+//  CF.STL_Containers_Span
+//
+//  Behavioural checks of the cspan kernels against naive references,
+//  run by ctest (the cspan_test target of the top-level CMakeLists.txt).
+//  Sizes and offsets are swept so the SIMD main loops, their tails and the
+//  scalar fallbacks are all reached. Each failed check is printed; the
+//  exit status is the number of failures (capped).
+//
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cspan.hpp"
+
+using namespace std::literals::string_literals;
+using namespace std::literals::string_view_literals;
+
+//  MARK: - namespace check
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace check {
+
+int failures { 0 };
+
+void expect(bool const ok, std::string_view const what,
+            std::source_location const where = std::source_location::current()) {
+  if (!ok) {
+    ++failures;
+    std::cerr << where.file_name() << ':' << where.line() << ": FAILED "s << what << '\n';
+  }
+}
+
+//  Values drawn from a small alphabet, so searches find partial matches.
+template<class T>
+std::vector<T> random_values(std::mt19937 & rng, std::size_t const count, unsigned const alphabet) {
+  std::vector<T> values(count);
+  std::generate(values.begin(), values.end(), [&rng, alphabet] { return static_cast<T>('a' + rng() % alphabet); });
+  return values;
+}
+
+} /* namespace check */
+
+//  MARK: - Tests
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+/*
+ *  MARK: search
+ *  contains / searcher against std::search: element, first-last and
+ *  Two-Way strategies, 1, 2, 4 and 8-byte elements.
+ */
+template<class T>
+void test_search_of(std::mt19937 & rng) {
+  for (std::size_t size { 0U }; size < 300U; size += 1U + size / 16U) {
+    for (auto const width : { 1U, 2U, 3U, 7U, 16U, 17U, 40U, }) {
+      for (auto const alphabet : { 2U, 4U, }) {
+        auto hay = check::random_values<T>(rng, size, alphabet);
+        auto needle = check::random_values<T>(rng, width, alphabet);
+        //  Plant the needle half the time.
+        if (size >= width && rng() % 2U == 0U) {
+          std::copy(needle.begin(), needle.end(), hay.begin() + static_cast<std::ptrdiff_t>(rng() % (size - width + 1U)));
+        }
+        auto const hspan = std::span<T const> { hay };
+        auto const nspan = std::span<T const> { needle };
+
+        auto const expect_at = static_cast<std::size_t>(std::search(hay.begin(), hay.end(), needle.begin(), needle.end())
+                                                        - hay.begin());
+        std::size_t expect_count { 0U };
+        for (std::size_t pos { 0U }; pos + width <= size; ++pos) {
+          expect_count += std::equal(needle.begin(), needle.end(), hay.begin() + static_cast<std::ptrdiff_t>(pos)) ? 1U : 0U;
+        }
+
+        cspan::searcher<T> const search { nspan };
+        auto const found = search.find_first(hspan);
+        check::expect(cspan::contains(hspan, nspan) == (expect_at != size), "contains"s);
+        check::expect((found == cspan::searcher<T>::npos ? size : found) == expect_at, "searcher::find_first"s);
+        check::expect(search.count(hspan) == expect_count, "searcher::count"s);
+      }
+    }
+  }
+}
+
+void test_search() {
+  std::mt19937 rng { 1U };
+  test_search_of<char>(rng);
+  test_search_of<std::uint16_t>(rng);
+  test_search_of<std::int32_t>(rng);
+  test_search_of<std::uint64_t>(rng);
+}
+
+/*
+ *  MARK: starts_with / ends_with
+ *  The run-time byte compare against std::equal: prefix and suffix
+ *  lengths across the 4, 8, 16 and 32-byte size classes, at unaligned
+ *  offsets, with a single differing element at every position (so a
+ *  mismatch in the tail alone shows).
+ */
+template<class T>
+void test_starts_ends_of(std::mt19937 & rng) {
+  auto agree { true };
+  for (std::size_t width { 0U }; width * sizeof(T) <= 72U; ++width) {
+    for (std::size_t offset { 0U }; offset != 3U; ++offset) {
+      auto const data = check::random_values<T>(rng, offset + width + 5U, 3U);
+      auto const all = std::span<T const> { data }.subspan(offset);
+      auto prefix = std::vector<T>(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(width));
+      auto suffix = std::vector<T>(all.end() - static_cast<std::ptrdiff_t>(width), all.end());
+      agree = agree && cspan::starts_with(all, std::span<T const> { prefix })
+                    && cspan::ends_with(all, std::span<T const> { suffix })
+                    && (width == 0U || !cspan::starts_with(all.first(width - 1U), std::span<T const> { prefix }));
+      for (std::size_t at { 0U }; at != width; ++at) {
+        prefix[at] = static_cast<T>(prefix[at] + 1);
+        suffix[at] = static_cast<T>(suffix[at] + 1);
+        auto const pspan = std::span<T const> { prefix };
+        auto const sspan = std::span<T const> { suffix };
+        agree = agree && cspan::starts_with(all, pspan) == std::equal(pspan.begin(), pspan.end(), all.begin())
+                      && cspan::ends_with(all, sspan)
+                         == std::equal(sspan.begin(), sspan.end(), all.end() - static_cast<std::ptrdiff_t>(width))
+                      && !cspan::starts_with(all, pspan) && !cspan::ends_with(all, sspan);
+        prefix[at] = static_cast<T>(prefix[at] - 1);
+        suffix[at] = static_cast<T>(suffix[at] - 1);
+      }
+    }
+  }
+  check::expect(agree, "starts_with / ends_with"s);
+}
+
+void test_starts_ends() {
+  std::mt19937 rng { 16U };
+  test_starts_ends_of<char>(rng);
+  test_starts_ends_of<std::uint16_t>(rng);
+  test_starts_ends_of<std::int32_t>(rng);
+  test_starts_ends_of<std::uint64_t>(rng);
+}
+
+/*
+ *  MARK: multi_searcher
+ *  Every (pattern, offset) against a naive std::search per pattern, in
+ *  end-position order; byte patterns with the DFA table and over its
+ *  budget, 16-bit ones with sparse edges. Duplicates and empty patterns
+ *  included.
+ */
+template<class T>
+void test_multi_search_of(std::mt19937 & rng, std::size_t const pattern_count, std::size_t const longest,
+                          unsigned const alphabet, std::size_t const hay_size) {
+  using match = typename cspan::multi_searcher<T>::match;
+  std::vector<std::vector<T>> patterns;
+  for (std::size_t ix { 0U }; ix != pattern_count; ++ix) {
+    patterns.push_back(check::random_values<T>(rng, rng() % (longest + 1U), alphabet));
+  }
+  patterns.push_back(patterns.front());
+  patterns.push_back({});
+  std::vector<std::span<T const>> views(patterns.begin(), patterns.end());
+  cspan::multi_searcher<T> const search { std::span<std::span<T const> const> { views } };
+  auto const hay = check::random_values<T>(rng, hay_size, alphabet);
+  auto const hspan = std::span<T const> { hay };
+
+  std::vector<std::pair<std::size_t, std::size_t>> expect;
+  for (std::size_t id { 0U }; id != patterns.size(); ++id) {
+    auto const & pattern = patterns[id];
+    for (auto at = hay.begin(); !pattern.empty(); ++at) {
+      at = std::search(at, hay.end(), pattern.begin(), pattern.end());
+      if (at == hay.end()) {
+        break;
+      }
+      expect.emplace_back(id, static_cast<std::size_t>(at - hay.begin()));
+    }
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> actual;
+  auto in_end_order { true };
+  std::size_t last_end { 0U };
+  search.for_each_match(hspan, [&](match const & found) {
+    auto const end = found.offset + patterns[found.pattern].size();
+    in_end_order = in_end_order && end >= last_end;
+    last_end = end;
+    actual.emplace_back(found.pattern, found.offset);
+    return true;
+  });
+  std::sort(expect.begin(), expect.end());
+  std::sort(actual.begin(), actual.end());
+  check::expect(actual == expect && in_end_order, "multi_searcher matches"s);
+  check::expect(search.count(hspan) == expect.size(), "multi_searcher::count"s);
+  check::expect(search.contains_any(hspan) == !expect.empty(), "multi_searcher::contains_any"s);
+  std::array<match, 3U> few;
+  check::expect(search.find_all(hspan, std::span { few }).size() == std::min<std::size_t>(3U, expect.size()),
+                "multi_searcher::find_all"s);
+}
+
+void test_multi_search() {
+  std::mt19937 rng { 9U };
+  for (int round { 0 }; round != 20; ++round) {
+    test_multi_search_of<char>(rng, 1U + rng() % 40U, 6U, 3U + rng() % 3U, 2'000U);
+    test_multi_search_of<std::uint16_t>(rng, 1U + rng() % 40U, 6U, 3U + rng() % 3U, 2'000U);
+  }
+  test_multi_search_of<char>(rng, 12'000U, 24U, 26U, 20'000U);
+}
+
+/*
+ *  MARK: windows / chunks
+ *  windows (runtime and static width, with strides), chunks and
+ *  chunks_exact against subspans cut by hand, down to spans shorter than
+ *  one window.
+ */
+void test_windows() {
+  std::vector<int> data(60U);
+  std::iota(data.begin(), data.end(), 0);
+  auto const is = [](auto const part, std::span<int const> const expect) {
+    return part.data() == expect.data() && part.size() == expect.size();
+  };
+  for (std::size_t size { 0U }; size <= data.size(); ++size) {
+    auto const span = std::span<int const> { data.data(), size };
+    for (auto const width : { 1U, 2U, 3U, 4U, 7U, 16U, }) {
+      for (auto const stride : { 1U, 2U, 4U, 5U, }) {
+        std::vector<std::span<int const>> expect;
+        for (std::size_t at { 0U }; at + width <= size; at += stride) {
+          expect.push_back(span.subspan(at, width));
+        }
+        auto const wins = cspan::windows(span, width, stride);
+        auto ok = wins.size() == expect.size() && wins.empty() == expect.empty();
+        std::size_t ix { 0U };
+        for (auto const win : wins) {
+          ok = ok && ix < expect.size() && is(win, expect[ix]) && is(wins[ix], expect[ix]);
+          ++ix;
+        }
+        check::expect(ok && ix == expect.size(), "windows"s);
+        if (width == 4U) {
+          auto const fixed = cspan::windows<4U>(span, stride);
+          check::expect(fixed.size() == expect.size()
+                        && std::equal(fixed.begin(), fixed.end(), expect.begin(), expect.end(), is),
+                        "windows<W>"s);
+        }
+      }
+
+      std::vector<std::span<int const>> expect;
+      for (std::size_t at { 0U }; at < size; at += width) {
+        expect.push_back(span.subspan(at, std::min<std::size_t>(width, size - at)));
+      }
+      auto const parts = cspan::chunks(span, width);
+      check::expect(parts.size() == expect.size()
+                    && std::equal(parts.begin(), parts.end(), expect.begin(), expect.end(), is),
+                    "chunks"s);
+
+      if (size % width != 0U) {
+        expect.pop_back();
+      }
+      auto const exact = cspan::chunks_exact(span, width);
+      check::expect(exact.size() == expect.size()
+                    && std::equal(exact.begin(), exact.end(), expect.begin(), expect.end(), is)
+                    && is(exact.remainder(), span.subspan(size - size % width)),
+                    "chunks_exact"s);
+      if (width == 4U) {
+        auto const fixed = cspan::chunks_exact<4U>(span);
+        check::expect(fixed.size() == expect.size()
+                      && std::equal(fixed.begin(), fixed.end(), expect.begin(), expect.end(), is)
+                      && is(fixed.remainder(), exact.remainder()),
+                      "chunks_exact<W>"s);
+      }
+    }
+  }
+}
+
+/*
+ *  MARK: filter
+ *  filter / filter_reverse with in_range (the compress kernels) against
+ *  std::copy_if.
+ */
+template<class T>
+void test_filter_of(std::mt19937 & rng) {
+  for (std::size_t size { 0U }; size != 200U; ++size) {
+    std::vector<T> in(size);
+    std::generate(in.begin(), in.end(), [&rng] { return static_cast<T>(rng() % 100U); });
+    cspan::in_range const pred { static_cast<T>(20), static_cast<T>(70) };
+
+    std::vector<T> expect;
+    std::copy_if(in.begin(), in.end(), std::back_inserter(expect), pred);
+    std::vector<T> out(size);
+    auto const kept = cspan::filter(std::span { in }, std::span { out }, pred);
+    check::expect(std::equal(kept.begin(), kept.end(), expect.begin(), expect.end()), "filter"s);
+
+    std::reverse(expect.begin(), expect.end());
+    auto const back = cspan::filter_reverse(std::span { in }, std::span { out }, pred);
+    check::expect(std::equal(back.begin(), back.end(), expect.begin(), expect.end()), "filter_reverse"s);
+  }
+}
+
+void test_filter() {
+  std::mt19937 rng { 2U };
+  test_filter_of<std::uint8_t>(rng);
+  test_filter_of<std::int32_t>(rng);
+  test_filter_of<double>(rng);
+}
+
+/*
+ *  MARK: reverse / rotate
+ */
+template<class T>
+void test_reverse_rotate_of() {
+  for (std::size_t size { 0U }; size != 160U; ++size) {
+    std::vector<T> values(size);
+    std::iota(values.begin(), values.end(), T {});
+
+    auto expect = values;
+    std::reverse(expect.begin(), expect.end());
+    auto actual = values;
+    cspan::reverse(std::span { actual });
+    check::expect(actual == expect, "reverse"s);
+
+    for (std::size_t shift { 0U }; shift <= size; shift += 1U + size / 8U) {
+      expect = values;
+      auto const first = std::rotate(expect.begin(), expect.begin() + static_cast<std::ptrdiff_t>(shift), expect.end());
+      actual = values;
+      auto const moved = cspan::rotate(std::span { actual }, shift);
+      check::expect(actual == expect, "rotate"s);
+      check::expect(moved == static_cast<std::size_t>(first - expect.begin()), "rotate result"s);
+    }
+  }
+}
+
+void test_reverse_rotate() {
+  test_reverse_rotate_of<std::uint8_t>();
+  test_reverse_rotate_of<std::uint16_t>();
+  test_reverse_rotate_of<std::int32_t>();
+  test_reverse_rotate_of<std::uint64_t>();
+}
+
+/*
+ *  MARK: rolling
+ *  rolling_sum (prefix-scan kernels), rolling_min / rolling_max against
+ *  per-window recomputation.
+ */
+void test_rolling() {
+  std::mt19937 rng { 3U };
+  for (std::size_t size { 0U }; size != 120U; ++size) {
+    std::vector<std::int32_t> in(size);
+    std::generate(in.begin(), in.end(), [&rng] { return static_cast<std::int32_t>(rng() % 1000U) - 500; });
+    std::vector<float> fin(in.begin(), in.end());
+    for (auto const width : { 1U, 2U, 3U, 5U, 8U, 17U, }) {
+      std::vector<std::int32_t> out(size);
+      std::vector<float> fout(size);
+      auto const sums = cspan::rolling_sum(std::span { in }, width, std::span { out });
+      auto const fsums = cspan::rolling_sum(std::span { fin }, width, std::span { fout });
+      auto const count = size >= width ? size - width + 1U : 0U;
+      check::expect(sums.size() == count && fsums.size() == count, "rolling_sum size"s);
+      for (std::size_t ix { 0U }; ix != std::min(count, sums.size()); ++ix) {
+        auto const first = in.begin() + static_cast<std::ptrdiff_t>(ix);
+        auto const sum = std::accumulate(first, first + width, 0);
+        check::expect(sums[ix] == sum, "rolling_sum int"s);
+        check::expect(fsums[ix] == static_cast<float>(sum), "rolling_sum float"s);
+      }
+
+      auto const lows = cspan::rolling_min(std::span { in }, width, std::span { out });
+      for (std::size_t ix { 0U }; ix != lows.size(); ++ix) {
+        auto const first = in.begin() + static_cast<std::ptrdiff_t>(ix);
+        check::expect(lows[ix] == *std::min_element(first, first + width), "rolling_min"s);
+      }
+      auto const highs = cspan::rolling_max(std::span { in }, width, std::span { out });
+      for (std::size_t ix { 0U }; ix != highs.size(); ++ix) {
+        auto const first = in.begin() + static_cast<std::ptrdiff_t>(ix);
+        check::expect(highs[ix] == *std::max_element(first, first + width), "rolling_max"s);
+      }
+    }
+  }
+
+  //  Signed sums that overflow wrap alike on the SIMD and scalar paths.
+  std::vector<std::int32_t> big(37U, std::numeric_limits<std::int32_t>::max() - 5);
+  big[20] = std::numeric_limits<std::int32_t>::min();
+  std::vector<std::int16_t> big16(big.size(), 30'000);
+  for (auto const width : { 1U, 2U, 3U, 9U, }) {
+    std::vector<std::int32_t> out(big.size());
+    std::vector<std::int16_t> out16(big.size());
+    auto const sums = cspan::rolling_sum(std::span { big }, width, std::span { out });
+    auto const sums16 = cspan::rolling_sum(std::span { big16 }, width, std::span { out16 });
+    for (std::size_t ix { 0U }; ix != sums.size(); ++ix) {
+      std::uint32_t sum { 0U };
+      std::uint16_t sum16 { 0U };
+      for (auto at { ix }; at != ix + width; ++at) {
+        sum += static_cast<std::uint32_t>(big[at]);
+        sum16 = static_cast<std::uint16_t>(sum16 + static_cast<std::uint16_t>(big16[at]));
+      }
+      check::expect(sums[ix] == static_cast<std::int32_t>(sum), "rolling_sum wraps"s);
+      check::expect(sums16[ix] == static_cast<std::int16_t>(sum16), "rolling_sum wraps, int16"s);
+    }
+  }
+}
+
+/*
+ *  MARK: format
+ *  Precisions too long for a field are clamped, not dropped; hex is sign
+ *  and magnitude.
+ */
+void test_format() {
+  auto const render = [](auto const span, cspan::format_options const & options) {
+    std::ostringstream sink;
+    {
+      std::array<char, 256U> storage;
+      cspan::format_buffer out { storage, sink };
+      cspan::format_to(out, span, options);
+    }
+    return sink.str();
+  };
+
+  std::vector<double> const values { 1.0 / 3.0, -2.5e300, 0.0, };
+  auto const precise = render(std::span { values }, { .precision = 200, });
+  std::array<char, 128U> expect;
+  std::string joined;
+  for (auto const value : values) {
+    auto const done = std::to_chars(expect.data(), expect.data() + expect.size(), value,
+                                    std::chars_format::general, static_cast<int>(cspan::format_buffer::field_max) - 8);
+    joined += (joined.empty() ? ""s : " "s) + std::string { expect.data(), done.ptr };
+  }
+  check::expect(precise == joined, "format clamps precision"s);
+  check::expect(render(std::span { values }, { .precision = 3, }) == "0.333 -2.5e+300 0"s, "format precision"s);
+
+  std::vector<int> const ints { -255, 255, -1, };
+  check::expect(render(std::span { ints }, { .base = cspan::base::hex, .separator = ",", }) == "-ff,ff,-1"s, "format hex"s);
+}
+
+/*
+ *  MARK: stream_reader
+ *  Chunks from a pipe carry their overlap; a reader dropped while its
+ *  worker waits on a quiet pipe returns without the writer closing it.
+ */
+void test_stream() {
+#if (CSPAN_HAS_STREAM_READER)
+  std::vector<std::byte> data(10'000U);
+  std::iota(reinterpret_cast<unsigned char *>(data.data()),
+            reinterpret_cast<unsigned char *>(data.data() + data.size()), static_cast<unsigned char>(0U));
+  for (auto const prefetch : { false, true, }) {
+    int fds[2];
+    check::expect(::pipe(fds) == 0, "pipe"s);
+    std::thread writer { [&data, fd = fds[1]] {
+      for (std::size_t done { 0U }; done != data.size(); ) {
+        auto const put = ::write(fd, data.data() + done, std::min<std::size_t>(data.size() - done, 777U));
+        done += put > 0 ? static_cast<std::size_t>(put) : 0U;
+      }
+      ::close(fd);
+    } };
+    cspan::stream_reader reader { fds[0], { .chunk_size = 1'000U, .overlap = 3U, .prefetch = prefetch, } };
+    auto intact { true };
+    std::size_t chunks { 0U };
+    for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next(), ++chunks) {
+      auto const expect = std::span<std::byte const> { data }.subspan(reader.offset(), chunk.size());
+      intact = intact && std::equal(chunk.begin(), chunk.end(), expect.begin(), expect.end())
+                      && (chunks == 0U || chunk.size() == 1'003U || reader.offset() + chunk.size() == data.size());
+    }
+    writer.join();
+    ::close(fds[0]);
+    check::expect(intact && chunks == 10U, "stream_reader chunks"s);
+  }
+
+  int fds[2];
+  check::expect(::pipe(fds) == 0, "pipe"s);
+  std::vector<std::byte> const first(4'096U, std::byte { 'x' });
+  check::expect(::write(fds[1], first.data(), first.size()) == static_cast<ssize_t>(first.size()), "pipe write"s);
+  std::atomic<bool> dropped { false };
+  std::thread consumer { [&dropped, fd = fds[0]] {
+    {
+      cspan::stream_reader reader { fd, { .chunk_size = 4'096U, } };
+      check::expect(reader.next().size() == 4'096U, "stream_reader first chunk"s);
+      //  Give the worker time to block on a second chunk that never comes.
+      std::this_thread::sleep_for(std::chrono::milliseconds { 50 });
+    }
+    dropped = true;
+  } };
+  for (int wait { 0 }; wait != 500 && !dropped; ++wait) {
+    std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+  }
+  check::expect(dropped, "stream_reader drop while the pipe is quiet"s);
+  ::close(fds[1]);
+  consumer.join();
+  ::close(fds[0]);
+#endif  /* (CSPAN_HAS_STREAM_READER) */
+}
+
+/*
+ *  MARK: mapped_span
+ *  A temporary file read back through read_only, copy_on_write and
+ *  read_write maps: contents, offsets, the invalid_argument cases, and
+ *  writes that reach the file or stay private.
+ */
+void test_mapped() {
+#if (CSPAN_HAS_MMAP)
+  std::mt19937 rng { 10U };
+  std::vector<std::uint32_t> data(3'000U);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<std::uint32_t>(rng()); });
+  auto const path = std::filesystem::temp_directory_path() / ("cspan_test_" + std::to_string(::getpid()) + ".bin");
+  auto const write_file = [&path](std::span<std::uint32_t const> const words) {
+    std::ofstream out { path, std::ios::binary | std::ios::trunc };
+    out.write(reinterpret_cast<char const *>(words.data()), static_cast<std::streamsize>(words.size_bytes()));
+  };
+  auto const read_file = [&path] {
+    std::ifstream in { path, std::ios::binary };
+    std::vector<std::uint32_t> words(std::filesystem::file_size(path) / sizeof(std::uint32_t));
+    in.read(reinterpret_cast<char *>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(std::uint32_t)));
+    return words;
+  };
+  auto const throws = [](auto const & make) {
+    try {
+      make();
+    }
+    catch (std::system_error const &) {
+      return true;
+    }
+    return false;
+  };
+  write_file(data);
+
+  {
+    cspan::mapped_span<std::uint32_t> const words { path, { .advice = cspan::map_advice::sequential, } };
+    auto const span = words.span();
+    check::expect(words.size() == data.size() && std::equal(span.begin(), span.end(), data.begin(), data.end()),
+                  "mapped_span read_only"s);
+    check::expect(words.file().size() == data.size() * sizeof(std::uint32_t)
+                  && words.file().mode() == cspan::map_mode::read_only, "mapped_file size, mode"s);
+
+    cspan::mapped_span<std::uint32_t> const tail { path, {}, 8U };
+    check::expect(std::equal(tail.span().begin(), tail.span().end(), data.begin() + 2, data.end()),
+                  "mapped_span offset"s);
+  }
+  check::expect(throws([&path] { cspan::mapped_span<std::uint64_t> { path, {}, 4U }; }), "mapped_span misaligned"s);
+  check::expect(throws([&path] { cspan::mapped_span<std::array<std::uint32_t, 7U>> { path }; }),
+                "mapped_span ragged size"s);
+  check::expect(throws([&path] { cspan::mapped_span<std::uint32_t> { path, {}, 1U << 20U }; }),
+                "mapped_span offset past end"s);
+  check::expect(throws([&path] { cspan::mapped_file { path.string() + ".missing" }; }), "mapped_file missing"s);
+  check::expect(throws([&path] {
+                  cspan::mapped_span<std::uint32_t> words { path };
+                  (void) words.writable_span();
+                }), "mapped_span read_only not writable"s);
+
+  {
+    cspan::mapped_span<std::uint32_t> words { path, { .mode = cspan::map_mode::copy_on_write, } };
+    std::fill(words.writable_span().begin(), words.writable_span().end(), 0U);
+    check::expect(words.span()[100] == 0U && read_file() == data, "mapped_span copy_on_write stays private"s);
+  }
+  {
+    cspan::mapped_span<std::uint32_t> words { path, { .mode = cspan::map_mode::read_write, .populate = true, } };
+    std::reverse(words.writable_span().begin(), words.writable_span().end());
+    words.file().sync();
+  }
+  std::reverse(data.begin(), data.end());
+  check::expect(read_file() == data, "mapped_span read_write reaches the file"s);
+
+  cspan::mapped_file whole { path };
+  auto const moved = std::move(whole);
+  check::expect(whole.empty() && whole.bytes().empty() && moved.size() == data.size() * sizeof(std::uint32_t),
+                "mapped_file move"s);
+  write_file({});
+  cspan::mapped_span<std::uint32_t> const none { path };
+  check::expect(none.size() == 0U && none.span().empty() && none.file().empty(), "mapped_span empty file"s);
+  std::filesystem::remove(path);
+#endif  /* (CSPAN_HAS_MMAP) */
+}
+
+/*
+ *  MARK: arena
+ *  Random sizes and alignments, some past the block size, from an
+ *  initial buffer and chained blocks: each allocation is aligned, keeps
+ *  its own contents, and rewind / reset / release hand back the same
+ *  addresses.
+ */
+void test_arena() {
+  std::mt19937 rng { 11U };
+  alignas(std::max_align_t) std::array<std::byte, 1'000U> initial;
+  for (auto const with_initial : { false, true, }) {
+    auto owner = with_initial ? cspan::arena { std::span { initial }, 512U } : cspan::arena { 512U };
+    for (int round { 0 }; round != 3; ++round) {
+      std::vector<std::pair<std::span<std::uint8_t>, std::uint8_t>> made;
+      auto aligned { true };
+      for (int ix { 0 }; ix != 200; ++ix) {
+        auto const align = std::size_t { 1U } << (rng() % 8U);
+        auto const count = rng() % 8U == 0U ? 600U + rng() % 600U : rng() % 100U;
+        auto const part = owner.allocate_span<std::uint8_t>(count, align);
+        aligned = aligned && reinterpret_cast<std::uintptr_t>(part.data()) % align == 0U && part.size() == count;
+        auto const fill = static_cast<std::uint8_t>(ix);
+        std::fill(part.begin(), part.end(), fill);
+        made.emplace_back(part, fill);
+      }
+      auto const intact = std::all_of(made.begin(), made.end(), [](auto const & entry) {
+        return std::all_of(entry.first.begin(), entry.first.end(), [&entry](auto const byte) { return byte == entry.second; });
+      });
+      check::expect(aligned, "arena alignment"s);
+      check::expect(intact, "arena allocations do not overlap"s);
+
+      auto const first = owner.mark();
+      auto const capacity = owner.capacity();
+      auto const again = owner.allocate(64U, 64U);
+      {
+        cspan::arena_scope const scratch { owner };
+        (void) owner.allocate(5'000U);
+      }
+      owner.rewind(first);
+      check::expect(owner.allocate(64U, 64U) == again, "arena rewind"s);
+      check::expect(owner.capacity() >= capacity, "arena rewind keeps blocks"s);
+
+      auto const total = owner.capacity();
+      owner.reset();
+      auto const reused = owner.allocate_span<std::uint64_t>(3U);
+      check::expect(owner.capacity() == total && (!with_initial || reused.data() == static_cast<void *>(initial.data())),
+                    "arena reset"s);
+      if (round == 1) {
+        owner.release();
+        check::expect(owner.capacity() == (with_initial ? initial.size() : 0U), "arena release"s);
+      }
+    }
+  }
+
+  cspan::arena owner { 256U };
+  std::vector<int> const src { 3, 1, 4, 1, 5, 9, 2, 6, };
+  auto const copy = owner.copy_span(std::span { src });
+  check::expect(copy.data() != src.data() && std::equal(copy.begin(), copy.end(), src.begin(), src.end()),
+                "arena copy_span"s);
+#if (defined(__cpp_lib_memory_resource))
+  cspan::arena_resource resource { owner };
+  std::pmr::vector<int> grown { &resource };
+  for (int ix { 0 }; ix != 1'000; ++ix) {
+    grown.push_back(ix);
+  }
+  check::expect(grown.size() == 1'000U && grown[999] == 999 && std::equal(copy.begin(), copy.end(), src.begin()),
+                "arena_resource"s);
+#endif  /* (defined(__cpp_lib_memory_resource)) */
+}
+
+/*
+ *  MARK: view_as / load_le / load_be / packed_view
+ *  Loads at every offset of an unaligned buffer against the value put
+ *  together byte by byte, in both byte orders; packed_view over records
+ *  wider than T; view_as on aligned bytes, and its two throwing paths.
+ */
+template<class T>
+void test_view_as_of(std::mt19937 & rng) {
+  using U = std::conditional_t<sizeof(T) == 1U, std::uint8_t,
+            std::conditional_t<sizeof(T) == 2U, std::uint16_t,
+            std::conditional_t<sizeof(T) == 4U, std::uint32_t, std::uint64_t>>>;
+  alignas(8) std::array<std::byte, 200U> data;
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<std::byte>(rng()); });
+  auto const bytes = std::span<std::byte const> { data };
+  //  Compared as bits, so a NaN pattern still matches itself.
+  auto const bits = [](T const value) { return std::bit_cast<U>(value); };
+  auto const reference = [&bytes](std::size_t const at, std::endian const order) {
+    U raw { 0U };
+    for (std::size_t ix { 0U }; ix != sizeof(T); ++ix) {
+      auto const from = order == std::endian::big ? at + ix : at + sizeof(T) - 1U - ix;
+      raw = static_cast<U>((raw << 8U) | std::to_integer<U>(bytes[from]));
+    }
+    return raw;
+  };
+
+  auto loads { true };
+  for (std::size_t at { 0U }; at + sizeof(T) <= bytes.size(); ++at) {
+    loads = loads && bits(cspan::load_le<T>(bytes, at)) == reference(at, std::endian::little)
+                  && bits(cspan::load_be<T>(bytes, at)) == reference(at, std::endian::big);
+  }
+  check::expect(loads, "load_le / load_be"s);
+
+  for (std::size_t offset { 0U }; offset != 9U; ++offset) {
+    for (auto const stride : { sizeof(T), sizeof(T) + 1U, std::size_t { 9U }, std::size_t { 24U }, }) {
+      auto const tail = bytes.subspan(offset);
+      auto const count = (tail.size() - sizeof(T)) / stride + 1U;
+      cspan::packed_view<T, std::endian::little> const little { tail, stride };
+      cspan::packed_view<T, std::endian::big> const big { tail, stride };
+      cspan::packed_view<T> const native { tail, stride };
+      auto packed { little.size() == count && big.size() == count && native.size() == count };
+      std::size_t ix { 0U };
+      for (auto const value : little) {
+        auto const at = offset + ix * stride;
+        packed = packed && bits(value) == reference(at, std::endian::little) && bits(little[ix]) == bits(value)
+                        && bits(big[ix]) == reference(at, std::endian::big)
+                        && bits(native.begin()[static_cast<std::ptrdiff_t>(ix)]) == reference(at, std::endian::native);
+        ++ix;
+      }
+      check::expect(packed && ix == count && big.end() - big.begin() == static_cast<std::ptrdiff_t>(count),
+                    "packed_view"s);
+    }
+  }
+
+  auto const view = cspan::view_as<T>(bytes.first(sizeof(T) * 10U));
+  auto viewed { view.size() == 10U && view.data() == static_cast<void const *>(bytes.data()) };
+  for (std::size_t ix { 0U }; ix != view.size(); ++ix) {
+    viewed = viewed && bits(view[ix]) == reference(ix * sizeof(T), std::endian::native);
+  }
+  check::expect(viewed, "view_as"s);
+  check::expect(cspan::view_as<T>(std::span { data }.first(sizeof(T) * 3U)).size() == 3U, "view_as writable"s);
+
+  auto const throws = [](auto const & make) {
+    try {
+      make();
+    }
+    catch (std::system_error const & error) {
+      return error.code() == std::errc::invalid_argument;
+    }
+    return false;
+  };
+  if constexpr (alignof(T) > 1U) {
+    check::expect(throws([&bytes] { (void) cspan::view_as<T>(bytes.subspan(1U, sizeof(T) * 4U)); }),
+                  "view_as misaligned"s);
+  }
+  if constexpr (sizeof(T) > 1U) {
+    check::expect(throws([&bytes] { (void) cspan::view_as<T>(bytes.first(sizeof(T) * 4U + 1U)); }),
+                  "view_as size mismatch"s);
+  }
+}
+
+void test_view_as() {
+  std::mt19937 rng { 15U };
+  test_view_as_of<std::uint8_t>(rng);
+  test_view_as_of<std::int16_t>(rng);
+  test_view_as_of<std::uint32_t>(rng);
+  test_view_as_of<std::int64_t>(rng);
+  test_view_as_of<float>(rng);
+  test_view_as_of<double>(rng);
+}
+
+/*
+ *  MARK: strided_span / span2d
+ *  strided_span and span2d element access, rows, columns, tiles and
+ *  views against index arithmetic; copy and transpose between row- and
+ *  column-major layouts, with padding and edges that are not a whole
+ *  tile, against a naive double loop.
+ */
+template<class T>
+void test_strided_of(std::mt19937 & rng) {
+  for (auto const & [rows, cols] : { std::pair { 0U, 5U }, { 1U, 1U }, { 3U, 70U }, { 65U, 2U }, { 100U, 130U }, }) {
+    auto const pad = rng() % 3U;
+    std::vector<T> flat((rows + pad) * (cols + pad));
+    std::iota(flat.begin(), flat.end(), T { 0 });
+    auto const at = [&flat, row_stride = cols + pad](std::size_t const row, std::size_t const col) {
+      return flat[row * row_stride + col];
+    };
+    cspan::span2d<T const> const view { flat.data(), rows, cols, cols + pad };
+
+    auto same { true };
+    for (std::size_t row { 0U }; row != rows; ++row) {
+      for (std::size_t col { 0U }; col != cols; ++col) {
+        same = same && view(row, col) == at(row, col) && view.row(row)[col] == at(row, col)
+                    && view.col(col)[row] == at(row, col) && view.transposed()(col, row) == at(row, col)
+                    && view.row_span(row)[col] == at(row, col);
+      }
+    }
+    check::expect(same && view.size() == rows * cols && view.empty() == (rows * cols == 0U), "span2d access"s);
+
+    std::vector<int> seen(rows * cols);
+    cspan::for_each_tile(view, 7U, 16U, [&](cspan::span2d<T const> const tile, std::size_t const row, std::size_t const col) {
+      for (std::size_t r { 0U }; r != tile.rows(); ++r) {
+        for (std::size_t c { 0U }; c != tile.cols(); ++c) {
+          seen[(row + r) * cols + col + c] += tile(r, c) == at(row + r, col + c) ? 1 : 2;
+        }
+      }
+    });
+    check::expect(std::all_of(seen.begin(), seen.end(), [](int const hits) { return hits == 1; }), "for_each_tile"s);
+
+    std::vector<T> row_major(rows * cols);
+    std::vector<T> col_major(cols * (rows + pad));
+    std::vector<T> transposed(rows * cols);
+    cspan::span2d<T> const by_row { std::span { row_major }, rows, cols };
+    cspan::span2d<T> const by_col { col_major.data(), rows, cols, 1U, rows + pad };
+    cspan::copy(view, by_row);
+    cspan::copy(cspan::span2d<T const> { by_row }, by_col);
+    cspan::transpose(cspan::span2d<T const> { by_col }, cspan::span2d<T> { std::span { transposed }, cols, rows });
+    auto copied { true };
+    for (std::size_t row { 0U }; row != rows; ++row) {
+      for (std::size_t col { 0U }; col != cols; ++col) {
+        copied = copied && row_major[row * cols + col] == at(row, col)
+                        && by_col(row, col) == at(row, col) && transposed[col * rows + row] == at(row, col);
+      }
+    }
+    check::expect(copied, "span2d copy / transpose"s);
+  }
+
+  std::vector<T> values(101U);
+  std::generate(values.begin(), values.end(), [&rng] { return static_cast<T>(rng() % 1'000U); });
+  for (auto const stride : { 1U, 2U, 3U, 10U, 101U, 200U, }) {
+    std::vector<T> expect;
+    for (std::size_t ix { 0U }; ix < values.size(); ix += stride) {
+      expect.push_back(values[ix]);
+    }
+    cspan::strided_span const every { std::span { values }, stride };
+    auto const part = every.subspan(1U, 4U);
+    auto const part_end = expect.begin() + static_cast<std::ptrdiff_t>(std::min<std::size_t>(5U, expect.size()));
+    check::expect(every.size() == expect.size() && std::equal(every.begin(), every.end(), expect.begin(), expect.end())
+                  && std::equal(part.begin(), part.end(), std::min(expect.begin() + 1, part_end), part_end),
+                  "strided_span"s);
+    std::sort(every.begin(), every.end());
+    std::sort(expect.begin(), expect.end());
+    check::expect(std::equal(every.begin(), every.end(), expect.begin(), expect.end())
+                  && every.back() == expect.back(), "strided_span sort in place"s);
+  }
+}
+
+void test_strided() {
+  std::mt19937 rng { 12U };
+  test_strided_of<std::uint8_t>(rng);
+  test_strided_of<float>(rng);
+  test_strided_of<std::uint64_t>(rng);
+}
+
+/*
+ *  MARK: soa
+ *  Growth, aliased push_back, copies and the aos round trip.
+ */
+void test_soa() {
+  struct particle {
+    float x;
+    double mass;
+    std::int16_t id;
+  };
+  using particles = cspan::soa<float, double, std::int16_t>;
+  auto const aligned = [](particles const & soa) {
+    return reinterpret_cast<std::uintptr_t>(soa.column<0>().data()) % particles::column_align == 0U
+        && reinterpret_cast<std::uintptr_t>(soa.column<1>().data()) % particles::column_align == 0U
+        && reinterpret_cast<std::uintptr_t>(soa.column<2>().data()) % particles::column_align == 0U;
+  };
+
+  //  push_back of the soa's own rows, through every regrowth.
+  particles soa;
+  soa.push_back(1.5F, 2.5, std::int16_t { 7 });
+  auto aliased { true };
+  for (std::size_t ix { 0U }; ix != 300U; ++ix) {
+    std::apply([&soa](auto const &... fields) { soa.push_back(fields...); }, soa.row(ix / 2U));
+    auto const [x, mass, id] = soa.row(soa.size() - 1U);
+    aliased = aliased && x == 1.5F && mass == 2.5 && id == 7;
+  }
+  check::expect(aliased && soa.size() == 301U && aligned(soa), "soa push_back of own row"s);
+
+  std::vector<particle> aos(1'000U);
+  for (std::size_t ix { 0U }; ix != aos.size(); ++ix) {
+    aos[ix] = { static_cast<float>(ix) * 0.5F, static_cast<double>(ix) * 3.0, static_cast<std::int16_t>(ix), };
+  }
+  cspan::aos_to_soa(std::span<particle const> { aos }, soa, &particle::x, &particle::mass, &particle::id);
+  auto columns_agree { soa.size() == aos.size() && aligned(soa) };
+  for (std::size_t ix { 0U }; columns_agree && ix != aos.size(); ++ix) {
+    columns_agree = soa.column<0>()[ix] == aos[ix].x && soa.column<1>()[ix] == aos[ix].mass
+                 && soa.column<2>()[ix] == aos[ix].id;
+  }
+  check::expect(columns_agree, "aos_to_soa"s);
+
+  for (auto [x, mass, id] : soa.rows()) {
+    x += 1.0F;
+    mass = -mass;
+    id = static_cast<std::int16_t>(-id);
+  }
+  auto const copy = soa;
+  auto again = particles { copy };
+  std::vector<particle> back(aos.size());
+  cspan::soa_to_aos(again, std::span { back }, &particle::x, &particle::mass, &particle::id);
+  auto round_trip { copy.size() == aos.size() && again.size() == aos.size() };
+  for (std::size_t ix { 0U }; round_trip && ix != aos.size(); ++ix) {
+    round_trip = back[ix].x == aos[ix].x + 1.0F && back[ix].mass == -aos[ix].mass && back[ix].id == -aos[ix].id;
+  }
+  check::expect(round_trip, "soa rows / copy / soa_to_aos"s);
+
+  again.resize(again.size() + 5U);
+  check::expect(again.column<1>().back() == 0.0 && again.column<2>().back() == 0, "soa resize value-initialises"s);
+  auto const taken = std::move(again);
+  check::expect(taken.size() == aos.size() + 5U && again.empty() && again.capacity() == 0U, "soa move"s);
+}
+
+/*
+ *  MARK: crc32c
+ *  Table and SSE4.2 paths against a bit-at-a-time CRC, and chaining.
+ */
+void test_crc32c() {
+  auto const bitwise = [](std::span<std::byte const> const bytes) {
+    std::uint32_t crc { ~0U };
+    for (auto const byte : bytes) {
+      crc ^= static_cast<std::uint32_t>(byte);
+      for (int bit { 0 }; bit != 8; ++bit) {
+        crc = (crc >> 1U) ^ (0x82f6'3b78U & (0U - (crc & 1U)));
+      }
+    }
+    return ~crc;
+  };
+
+  std::string_view constexpr digits { "123456789" };
+  check::expect(cspan::crc32c(std::as_bytes(std::span { digits })) == 0xE306'9283U, "crc32c check value"s);
+
+  std::mt19937 rng { 4U };
+  std::vector<std::byte> data(10'000U);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<std::byte>(rng()); });
+  for (auto const size : { 0U, 1U, 7U, 8U, 63U, 1'024U, 3'000U, 3'073U, 10'000U, }) {
+    auto const bytes = std::span<std::byte const> { data }.first(size);
+    auto const crc = cspan::crc32c(bytes);
+    check::expect(crc == bitwise(bytes), "crc32c"s);
+    auto const half = size / 2U;
+    check::expect(cspan::crc32c(bytes.subspan(half), cspan::crc32c(bytes.first(half))) == crc, "crc32c chained"s);
+  }
+
+  //  The hardware path against the table path, every size and offset
+  //  around the three-stream split.
+#if (CSPAN_HAS_TARGET)
+  if (cspan::cpu().sse42) {
+    auto agree { true };
+    for (std::size_t offset { 0U }; offset != 8U; ++offset) {
+      for (std::size_t size { 0U }; offset + size <= data.size(); size += 1U + size / 7U) {
+        auto const bytes = std::span<std::byte const> { data }.subspan(offset, size);
+        agree = agree && cspan::detail::crc32c_sse42(~0U, bytes.data(), bytes.size())
+                      == cspan::detail::crc32c_scalar(~0U, bytes.data(), bytes.size());
+      }
+    }
+    check::expect(agree, "crc32c sse4.2 == tables"s);
+  }
+#endif  /* (CSPAN_HAS_TARGET) */
+}
+
+/*
+ *  MARK: hasher
+ *  hasher fed any split of a buffer digests to hash() of the whole.
+ */
+void test_hasher() {
+  std::mt19937 rng { 7U };
+  std::vector<std::byte> data(5'000U);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<std::byte>(rng()); });
+  auto agree { true };
+  for (std::size_t size { 0U }; size < data.size(); size += 1U + size / 5U) {
+    auto const whole = std::span<std::byte const> { data }.first(size);
+    for (auto const seed : { 0ULL, 0x1234'5678'9abc'def0ULL, }) {
+      auto const expect = cspan::hash(whole, seed);
+      for (int split { 0 }; split != 8; ++split) {
+        cspan::hasher pieces { seed };
+        for (auto rest = whole; !rest.empty(); ) {
+          //  Mostly short pieces, so stripes straddle them; some long ones.
+          auto const limit = split % 2 == 0 ? 60U : 300U;
+          auto const part = std::min<std::size_t>(rest.size(), rng() % limit);
+          pieces.update(rest.first(part));
+          rest = rest.subspan(part);
+        }
+        agree = agree && pieces.digest() == expect && pieces.size() == size;
+      }
+      cspan::hasher chunked { seed };
+      chunked.update_each(cspan::chunks(whole, 48U));
+      agree = agree && chunked.digest() == expect;
+    }
+  }
+  check::expect(agree, "hasher == hash"s);
+}
+
+/*
+ *  MARK: rabin_karp / content_chunks
+ *  roll() and rolling_hash() against prime() of each window; chunks
+ *  against a cutter that primes every candidate window afresh, down to
+ *  avg_size == min_size + 1 (a zero-bit mask: every chunk is min_size).
+ *  An early insertion leaves the later boundaries where they were.
+ */
+void test_rolling_hash() {
+  std::mt19937 rng { 14U };
+  std::vector<std::byte> data(40'000U);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<std::byte>(rng()); });
+  auto const bytes = std::span<std::byte const> { data };
+
+  for (auto const width : { 1U, 2U, 7U, 16U, 48U, 300U, }) {
+    auto const input = bytes.first(3'000U);
+    cspan::rabin_karp roller { width };
+    cspan::rabin_karp fresh { width };
+    auto rolls { roller.prime(input.first(width)) == fresh.prime(input.first(width)) };
+    std::vector<std::uint64_t> out(input.size());
+    auto const hashes = cspan::rolling_hash(input, width, std::span { out });
+    rolls = rolls && hashes.size() == input.size() - width + 1U && hashes[0] == roller.value();
+    for (std::size_t ix { 1U }; ix != hashes.size(); ++ix) {
+      auto const expect = fresh.prime(input.subspan(ix, width));
+      rolls = rolls && roller.roll(input[ix - 1U], input[ix + width - 1U]) == expect && hashes[ix] == expect;
+    }
+    check::expect(rolls, "rabin_karp roll, rolling_hash"s);
+    check::expect(cspan::rolling_hash(input.first(width - 1U), width, std::span { out }).empty(), "rolling_hash short"s);
+  }
+
+  //  Reference: a boundary after the first window ending at or past
+  //  min_size whose hash has its top `bits` clear.
+  auto const reference = [](std::span<std::byte const> rest, cspan::chunk_options const & options) {
+    auto const bits = static_cast<unsigned>(std::bit_width(options.avg_size - options.min_size) - 1);
+    cspan::rabin_karp fresh { options.window };
+    std::vector<std::size_t> sizes;
+    while (!rest.empty()) {
+      auto size = std::min(rest.size(), options.max_size);
+      for (auto pos = options.min_size; pos < size; ++pos) {
+        auto const value = fresh.prime(rest.subspan(pos - options.window, options.window));
+        if (bits == 0U || value >> (64U - bits) == 0U) {
+          size = pos;
+        }
+      }
+      sizes.push_back(size);
+      rest = rest.subspan(size);
+    }
+    return sizes;
+  };
+  auto const cut = [](std::span<std::byte const> const input, cspan::chunk_options const & options) {
+    std::vector<std::size_t> sizes;
+    auto tiles { true };
+    auto const * next = input.data();
+    for (auto const chunk : cspan::content_chunks(input, options)) {
+      tiles = tiles && chunk.data() == next && chunk.size() <= options.max_size
+                    && (chunk.size() >= options.min_size || next + chunk.size() == input.data() + input.size());
+      next += chunk.size();
+      sizes.push_back(chunk.size());
+    }
+    check::expect(tiles && next == input.data() + input.size(), "content_chunks tile the input"s);
+    return sizes;
+  };
+
+  for (auto const & options : {
+         cspan::chunk_options { .min_size = 256U, .avg_size = 1'024U, .max_size = 4'096U, .window = 32U, },
+         cspan::chunk_options { .min_size = 100U, .avg_size = 3'000U, .max_size = 3'000U, .window = 100U, },
+         cspan::chunk_options { .min_size = 64U, .avg_size = 65U, .max_size = 1'024U, .window = 16U, },
+         cspan::chunk_options { .min_size = 64U, .avg_size = 66U, .max_size = 1'024U, .window = 16U, }, }) {
+    for (auto const size : { 0U, 1U, 64U, 65U, 5'000U, 40'000U, }) {
+      auto const input = bytes.first(size);
+      check::expect(cut(input, options) == reference(input, options), "content_chunks boundaries"s);
+    }
+  }
+  auto const every = cut(bytes.first(1'000U), { .min_size = 64U, .avg_size = 65U, .max_size = 1'024U, .window = 16U, });
+  check::expect(every.size() == 16U && std::all_of(every.begin(), every.end() - 1, [](auto const size) { return size == 64U; })
+                && every.back() == 1'000U % 64U, "content_chunks zero-bit mask"s);
+
+  cspan::chunk_options const options { .min_size = 256U, .avg_size = 1'024U, .max_size = 4'096U, .window = 32U, };
+  auto edited = data;
+  edited.insert(edited.begin() + 100, std::byte { 0x5a });
+  auto const ends_from_back = [](std::vector<std::size_t> const & sizes) {
+    std::vector<std::size_t> ends;
+    std::size_t left { 0U };
+    for (auto at = sizes.rbegin(); at != sizes.rend(); ++at) {
+      ends.push_back(left);
+      left += *at;
+    }
+    return ends;
+  };
+  auto const before = ends_from_back(cut(bytes, options));
+  auto const after = ends_from_back(cut(std::span<std::byte const> { edited }, options));
+  auto const far = std::count_if(before.begin(), before.end(), [&](auto const end) { return end + 8U * options.max_size < data.size(); });
+  check::expect(far > 0 && std::equal(before.begin(), before.begin() + far, after.begin(), after.begin() + far),
+                "content_chunks resync after an insertion"s);
+}
+
+/*
+ *  MARK: ring
+ *  Order and completeness across threads, spsc and mpmc.
+ */
+void test_ring() {
+#if (CSPAN_HAS_MMAP)
+  {
+    cspan::ring<std::uint64_t> queue { 256U };
+    std::uint64_t constexpr total { 200'000U };
+    std::thread producer { [&queue] {
+      std::uint64_t next { 0U };
+      while (next < total) {
+        auto const out = queue.reserve(std::min<std::uint64_t>(total - next, 1U + next % 37U));
+        if (out.empty()) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (auto & value : out) {
+          value = next++;
+        }
+        queue.commit(out);
+      }
+    } };
+    std::uint64_t expect { 0U };
+    auto in_order { true };
+    while (expect < total) {
+      auto const in = queue.peek(50U);
+      if (in.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (auto const value : in) {
+        in_order = in_order && value == expect++;
+      }
+      queue.release(in);
+    }
+    producer.join();
+    check::expect(in_order && queue.size() == 0U, "ring spsc order"s);
+  }
+  {
+    cspan::ring<std::uint64_t, cspan::ring_mode::mpmc> queue { 512U };
+    std::uint64_t constexpr producers { 3U };
+    std::uint64_t constexpr per { 50'000U };
+    std::atomic<std::uint64_t> sum { 0U };
+    std::atomic<std::uint64_t> count { 0U };
+    std::vector<std::thread> threads;
+    for (std::uint64_t p { 0U }; p != producers; ++p) {
+      threads.emplace_back([&queue, p] {
+        std::uint64_t ix { 0U };
+        while (ix < per) {
+          auto const out = queue.reserve(std::min<std::uint64_t>(per - ix, 1U + ix % 13U));
+          if (out.empty()) {
+            std::this_thread::yield();
+            continue;
+          }
+          for (auto & value : out) {
+            value = p * per + ++ix;
+          }
+          queue.commit(out);
+        }
+      });
+    }
+    for (int c { 0 }; c != 3; ++c) {
+      threads.emplace_back([&] {
+        while (count.load() < producers * per) {
+          auto const in = queue.peek(17U);
+          if (in.empty()) {
+            std::this_thread::yield();
+            continue;
+          }
+          auto const part = std::accumulate(in.begin(), in.end(), std::uint64_t { 0U });
+          auto const taken = in.size();
+          queue.release(in);
+          sum += part;
+          count += taken;
+        }
+      });
+    }
+    //  size() from a bystander, while both ends move, stays in range.
+    auto bounded { true };
+    while (count.load() < producers * per) {
+      bounded = bounded && queue.size() <= queue.capacity();
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    auto const n = producers * per;
+    check::expect(count == n && sum == n * (n + 1U) / 2U, "ring mpmc sum"s);
+    check::expect(bounded, "ring size() <= capacity()"s);
+  }
+#endif  /* (CSPAN_HAS_MMAP) */
+}
+
+/*
+ *  MARK: thread_pool / par
+ *  Parallel results against sequential ones, on more participants than
+ *  there may be cores; exceptions reach the caller.
+ */
+void test_parallel() {
+  cspan::par::thread_pool pool { 4U };
+  std::mt19937 rng { 5U };
+  auto const values = check::random_values<char>(rng, 100'003U, 3U);
+  auto const span = std::span { values };
+  for (auto const width : { 1U, 5U, 12U, }) {
+    auto const needle = check::random_values<char>(rng, width, 3U);
+    auto const nspan = std::span { needle };
+    std::size_t expect { 0U };
+    for (std::size_t pos { 0U }; pos + width <= values.size(); ++pos) {
+      expect += std::equal(needle.begin(), needle.end(), values.begin() + static_cast<std::ptrdiff_t>(pos)) ? 1U : 0U;
+    }
+    check::expect(cspan::par::count(pool, span, nspan) == expect, "par::count"s);
+    check::expect(cspan::par::contains(pool, span, nspan) == (expect != 0U), "par::contains"s);
+  }
+
+  std::vector<long> numbers(100'000U);
+  std::iota(numbers.begin(), numbers.end(), 1L);
+  check::expect(cspan::par::reduce(pool, std::span { numbers }, 0L, std::plus<> {}) == 5'000'050'000L, "par::reduce"s);
+  auto const positive = [](auto const all, auto const n) { return static_cast<bool>(all) && n > 0; };
+  check::expect(cspan::par::reduce(pool, std::span { numbers }, true, positive), "par::reduce to bool"s);
+  numbers[77'777U] = -1L;
+  check::expect(!cspan::par::reduce(pool, std::span { numbers }, true, positive), "par::reduce to bool, false"s);
+  numbers[77'777U] = 77'778L;
+
+  //  par:: calls from inside the pool's own tasks run inline.
+  std::atomic<std::size_t> nested { 0U };
+  pool.run(8U, [&](std::size_t) {
+    nested += cspan::par::reduce(pool, std::span { numbers }, 0L, std::plus<> {}) == 5'000'050'000L ? 1U : 0U;
+  });
+  check::expect(nested == 8U, "nested par::reduce"s);
+
+  std::vector<long> squares(numbers.size());
+  cspan::par::transform(pool, std::span { numbers }, std::span { squares }, [](long const n) { return n * n; });
+  auto all_squared { true };
+  for (std::size_t ix { 0U }; ix != numbers.size(); ++ix) {
+    all_squared = all_squared && squares[ix] == numbers[ix] * numbers[ix];
+  }
+  check::expect(all_squared, "par::transform"s);
+
+  std::atomic<std::size_t> windows { 0U };
+  cspan::par::for_each_window(pool, std::span { numbers }, 10U, [&windows](std::span<long const> const window) {
+    windows += window.back() - window.front() == 9L ? 1U : 0U;
+  });
+  check::expect(windows == numbers.size() - 9U, "par::for_each_window"s);
+
+  auto caught { false };
+  try {
+    pool.run(64U, [](std::size_t const ix) {
+      if (ix == 40U) {
+        throw std::runtime_error { "task 40" };
+      }
+    });
+  }
+  catch (std::runtime_error const &) {
+    caught = true;
+  }
+  check::expect(caught, "thread_pool rethrows"s);
+}
+
+/*
+ *  MARK: search trees
+ *  eytzinger_index / static_btree, single and batched, against
+ *  std::lower_bound; every size up to a few nodes deep, duplicates, and
+ *  queries below, between, on and above the values.
+ */
+template<class T>
+void test_search_tree_of(std::mt19937 & rng) {
+  for (std::size_t size { 0U }; size < 600U; size += 1U + size / 32U) {
+    std::vector<T> sorted(size);
+    std::generate(sorted.begin(), sorted.end(), [&rng] { return static_cast<T>(rng() % 3'000U) - static_cast<T>(1'500); });
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<T> queries { std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), };
+    for (auto const value : sorted) {
+      queries.insert(queries.end(), { static_cast<T>(value - 1), value, static_cast<T>(value + 1), });
+    }
+
+    auto const span = std::span<T const> { sorted };
+    cspan::eytzinger_index const eytzinger { span };
+    cspan::static_btree const btree { span };
+    std::vector<std::size_t> batched_e(queries.size());
+    std::vector<std::size_t> batched_b(queries.size());
+    eytzinger.lower_bound(std::span<T const> { queries }, std::span { batched_e });
+    btree.lower_bound(std::span<T const> { queries }, std::span { batched_b });
+
+    auto agree { true };
+    for (std::size_t ix { 0U }; ix != queries.size(); ++ix) {
+      auto const expect = static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), queries[ix])
+                                                   - sorted.begin());
+      agree = agree && eytzinger.lower_bound(queries[ix]) == expect && batched_e[ix] == expect
+                    && btree.lower_bound(queries[ix]) == expect && batched_b[ix] == expect;
+    }
+    check::expect(agree, "search tree lower_bound, size "s + std::to_string(size));
+  }
+}
+
+void test_search_tree() {
+  std::mt19937 rng { 6U };
+  test_search_tree_of<std::int32_t>(rng);
+  test_search_tree_of<std::int16_t>(rng);
+  test_search_tree_of<double>(rng);
+}
+
+/*
+ *  MARK: pipeline
+ *  map -> filter -> windows against the same steps through vectors, with
+ *  filters sparse enough that windows span several blocks.
+ */
+void test_pipeline() {
+  std::mt19937 rng { 8U };
+  std::vector<int> data(3'000U);
+  std::generate(data.begin(), data.end(), [&rng] { return static_cast<int>(rng() % 1'000U); });
+  auto const map = [](int const val) { return val * 3 + 1; };
+  auto const window_sum = [](std::span<int const> const win) { return std::accumulate(win.begin(), win.end(), 0L); };
+  for (auto const every : { 1, 7, 300, }) {
+    auto const keep = [every](int const val) { return val % every == 0; };
+    std::vector<int> kept;
+    for (auto const val : data) {
+      if (keep(map(val))) {
+        kept.push_back(map(val));
+      }
+    }
+    for (auto const width : { 1U, 2U, 9U, 256U, }) {
+      std::vector<long> expect;
+      for (std::size_t ix { 0U }; ix + width <= kept.size(); ++ix) {
+        expect.push_back(window_sum(std::span<int const> { kept.data() + ix, width }));
+      }
+      std::vector<long> actual(data.size());
+      auto const made = cspan::pipeline { std::span { data } }.map(map).filter(keep).windows(width, window_sum)
+                          .collect(std::span { actual });
+      check::expect(std::equal(made.begin(), made.end(), expect.begin(), expect.end()), "pipeline windows"s);
+    }
+  }
+  check::expect(cspan::pipeline { std::span { data } }.windows<4U>(4U, window_sum).count() == data.size() - 3U,
+                "pipeline windows<MaxWidth>"s);
+}
+
+/*
+ *  MARK: inline_buffer
+ *  push_back / pop_back / resize against std::vector across the spill
+ *  past N, to the heap and to an arena; copies and moves from inline and
+ *  spilled buffers, and the moved-from state. Elements count themselves,
+ *  so a lost or doubled destructor shows.
+ */
+struct counted {
+  static inline int live { 0 };
+  std::string text;
+
+  explicit counted(std::string value = {}) : text { std::move(value) } { ++live; }
+  counted(counted const & other) : text { other.text } { ++live; }
+  counted(counted && other) noexcept : text { std::move(other.text) } { ++live; }
+  counted & operator=(counted const &) = default;
+  counted & operator=(counted &&) noexcept = default;
+  ~counted() { --live; }
+
+  friend bool operator==(counted const & lhs, std::string const & rhs) { return lhs.text == rhs; }
+};
+
+template<std::size_t N>
+void test_inline_buffer_of(cspan::arena * const spill) {
+  using buffer = cspan::inline_buffer<counted, N>;
+  auto const same = [](buffer const & buf, std::vector<std::string> const & expect) {
+    return buf.size() == expect.size() && buf.capacity() >= buf.size()
+        && std::equal(buf.begin(), buf.end(), expect.begin(), expect.end());
+  };
+  {
+    auto buf = spill != nullptr ? buffer { *spill } : buffer {};
+    std::vector<std::string> expect;
+    auto grows { true };
+    for (std::size_t ix { 0U }; ix != 3U * N + 5U; ++ix) {
+      expect.push_back("value number "s + std::to_string(ix));
+      buf.emplace_back(expect.back());
+      grows = grows && same(buf, expect) && buf.is_inline() == (ix < N);
+    }
+    check::expect(grows, "inline_buffer spill"s);
+    auto const grown = expect;
+
+    buffer small { std::span { expect }.first(N) };
+    small.push_back(small.front());
+    expect.resize(N);
+    expect.push_back(expect.front());
+    check::expect(same(small, expect) && !small.is_inline(), "inline_buffer push_back of own element at the spill"s);
+
+    small.pop_back();
+    expect.pop_back();
+    small.resize(N + 3U);
+    expect.resize(N + 3U);
+    check::expect(same(small, expect), "inline_buffer resize up"s);
+    small.resize(1U);
+    expect.resize(1U);
+    check::expect(same(small, expect), "inline_buffer resize down"s);
+
+    auto const copy = buf;
+    auto copied = buffer {};
+    copied = small;
+    check::expect(same(copy, grown) && copy.data() != buf.data()
+                  && same(copied, expect), "inline_buffer copy"s);
+
+    auto const spilled_at = buf.data();
+    auto const moved = std::move(buf);
+    check::expect(moved.data() == spilled_at && moved.size() == 3U * N + 5U, "inline_buffer move steals spilled storage"s);
+    check::expect(buf.empty() && buf.is_inline() && buf.capacity() == N, "inline_buffer moved-from spilled"s);
+
+    buffer few { counted { "a" }, counted { "b" }, };
+    auto taken = std::move(few);
+    check::expect(same(taken, { "a", "b", }) && taken.is_inline() == (N >= 2U), "inline_buffer move from inline"s);
+    check::expect(few.empty() && few.is_inline() && few.capacity() == N, "inline_buffer moved-from inline"s);
+    few.push_back(counted { "c" });
+    check::expect(same(few, { "c", }), "inline_buffer reuse after move"s);
+
+    taken = std::move(copied);
+    copied = std::move(few);
+    check::expect(same(taken, expect) && same(copied, { "c", }) && few.empty(), "inline_buffer move assign"s);
+    taken.clear();
+    check::expect(taken.empty(), "inline_buffer clear"s);
+  }
+  check::expect(counted::live == 0, "inline_buffer destroys each element once"s);
+
+  cspan::inline_buffer<int, N> ints;
+  ints.resize(N);
+  std::iota(ints.begin(), ints.end(), 1);
+  std::span<int const> const all = ints;
+  std::span<int, N> const fixed = ints;
+  check::expect(all.data() == ints.data() && fixed.size() == N && fixed.back() == static_cast<int>(N),
+                "inline_buffer as span"s);
+}
+
+void test_inline_buffer() {
+  test_inline_buffer_of<1U>(nullptr);
+  test_inline_buffer_of<4U>(nullptr);
+  cspan::arena spill { 256U };
+  test_inline_buffer_of<4U>(&spill);
+  check::expect(spill.capacity() != 0U, "inline_buffer spills into its arena"s);
+}
+
+/*
+ *  MARK: static_set / perfect_hash
+ *  Tables built constexpr are checked by static_assert: every key found
+ *  at its index, misses are npos, duplicates fold. At run time, random
+ *  key sets against std::sort / std::unique / std::lower_bound, and a
+ *  duplicate key throws.
+ */
+namespace static_tables {
+
+std::string_view constexpr keywords[] {
+  "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+  "extern", "float", "for", "goto", "if", "int", "long", "register", "return", "short",
+};
+cspan::perfect_hash constexpr keyword_hash { std::span { keywords } };
+
+template<class Table, std::size_t N>
+constexpr bool finds_each(Table const & table, std::span<typename Table::key_type const, N> const keys) {
+  for (std::size_t ix { 0U }; ix != keys.size(); ++ix) {
+    if (table.find(keys[ix]) != ix) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(finds_each(keyword_hash, std::span { keywords }));
+static_assert(keyword_hash.find(""sv) == keyword_hash.npos && keyword_hash.find("Break"sv) == keyword_hash.npos
+              && keyword_hash.find("whil"sv) == keyword_hash.npos && keyword_hash.find("shorts"sv) == keyword_hash.npos);
+
+int constexpr primes[] { 0x7FFF'FFFF, 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, -1, };
+cspan::perfect_hash constexpr prime_hash { std::span { primes } };
+static_assert(finds_each(prime_hash, std::span { primes }));
+static_assert(!prime_hash.contains(0) && !prime_hash.contains(4) && !prime_hash.contains(-2) && !prime_hash.contains(31));
+
+int constexpr raw[] { 9, 3, 7, 3, 1, 9, 5, 9, };
+cspan::static_set constexpr digits { std::span { raw } };
+static_assert(digits.size() == 5U && digits[0] == 1 && digits[4] == 9
+              && std::is_sorted(digits.begin(), digits.end()));
+static_assert(digits.find(1) == 0U && digits.find(5) == 2U && digits.find(9) == 4U);
+static_assert(digits.find(0) == digits.size() && digits.find(4) == digits.size() && digits.find(10) == digits.size());
+
+constexpr bool lower_bound_agrees() {
+  auto const sorted = cspan::sorted(std::span { raw });
+  for (int value { -1 }; value != 12; ++value) {
+    auto const ix = cspan::lower_bound(std::span { sorted }, value);
+    if (ix != static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin())
+        || cspan::binary_search(std::span { sorted }, value) != std::binary_search(sorted.begin(), sorted.end(), value)) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(lower_bound_agrees());
+
+} /* namespace static_tables */
+
+void test_static() {
+  std::mt19937 rng { 13U };
+  std::vector<std::uint32_t> drawn(1'500U);
+  std::generate(drawn.begin(), drawn.end(), [&rng] { return static_cast<std::uint32_t>(rng() % 100'000U); });
+  std::array<std::uint32_t, 1'000U> keys {};
+  std::copy_n(drawn.begin(), keys.size(), keys.begin());
+
+  auto expect = drawn;
+  expect.resize(keys.size());
+  std::sort(expect.begin(), expect.end());
+  expect.erase(std::unique(expect.begin(), expect.end()), expect.end());
+  cspan::static_set const set { std::span<std::uint32_t const, 1'000U> { keys } };
+  check::expect(std::equal(set.begin(), set.end(), expect.begin(), expect.end()), "static_set contents"s);
+  auto found { true };
+  for (auto const probe : drawn) {
+    auto const at = static_cast<std::size_t>(std::lower_bound(expect.begin(), expect.end(), probe) - expect.begin());
+    auto const hit = at != expect.size() && expect[at] == probe;
+    found = found && set.find(probe) == (hit ? at : set.size()) && set.contains(probe) == hit
+                  && cspan::lower_bound(set.values(), probe) == at;
+  }
+  check::expect(found, "static_set find"s);
+
+  std::sort(keys.begin(), keys.end());
+  auto const distinct = std::unique(keys.begin(), keys.end());
+  for (auto at = distinct; at != keys.end(); ++at) {
+    *at = 100'000U + static_cast<std::uint32_t>(at - keys.begin());
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  cspan::perfect_hash const hash { std::span<std::uint32_t const, 1'000U> { keys } };
+  auto all_found { true };
+  for (std::size_t ix { 0U }; ix != keys.size(); ++ix) {
+    all_found = all_found && hash.find(keys[ix]) == ix;
+  }
+  auto misses { true };
+  for (std::uint32_t probe { 0U }; probe < 300'000U; probe += 7U) {
+    auto const known = std::find(keys.begin(), keys.end(), probe) != keys.end();
+    misses = misses && hash.contains(probe) == known;
+  }
+  check::expect(all_found && misses, "perfect_hash find"s);
+
+  std::vector<std::string> names;
+  for (std::size_t ix { 0U }; ix != 64U; ++ix) {
+    names.push_back("name_"s + std::to_string(ix * 37U));
+  }
+  std::array<std::string_view, 64U> views {};
+  std::copy(names.begin(), names.end(), views.begin());
+  cspan::perfect_hash const by_name { std::span<std::string_view const, 64U> { views } };
+  auto named { by_name.find("name_"sv) == by_name.npos && by_name.find("name_1"sv) == by_name.npos };
+  for (std::size_t ix { 0U }; ix != views.size(); ++ix) {
+    named = named && by_name.find(views[ix]) == ix;
+  }
+  check::expect(named, "perfect_hash string keys"s);
+
+  views[40] = views[3];
+  auto rejected { false };
+  try {
+    cspan::perfect_hash const duplicate { std::span<std::string_view const, 64U> { views } };
+    (void) duplicate;
+  }
+  catch (std::system_error const & error) {
+    rejected = error.code() == std::errc::invalid_argument;
+  }
+  check::expect(rejected, "perfect_hash duplicate key"s);
+}
+
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+/*
+ *  MARK: main()
+ */
+int main() {
+  struct entry {
+    std::string_view name;
+    void (*run)();
+  };
+  entry constexpr tests[] {
+    { "search",         test_search,         },
+    { "starts_ends",    test_starts_ends,    },
+    { "multi_search",   test_multi_search,   },
+    { "windows",        test_windows,        },
+    { "filter",         test_filter,         },
+    { "reverse_rotate", test_reverse_rotate, },
+    { "rolling",        test_rolling,        },
+    { "format",         test_format,         },
+    { "stream",         test_stream,         },
+    { "mapped",         test_mapped,         },
+    { "arena",          test_arena,          },
+    { "view_as",        test_view_as,        },
+    { "strided",        test_strided,        },
+    { "soa",            test_soa,            },
+    { "crc32c",         test_crc32c,         },
+    { "hasher",         test_hasher,         },
+    { "rolling_hash",   test_rolling_hash,   },
+    { "ring",           test_ring,           },
+    { "parallel",       test_parallel,       },
+    { "search_tree",    test_search_tree,    },
+    { "pipeline",       test_pipeline,       },
+    { "inline_buffer",  test_inline_buffer,  },
+    { "static",         test_static,         },
+  };
+
+  for (auto const & [name, run] : tests) {
+    auto const before = check::failures;
+    run();
+    std::cout << (check::failures == before ? "ok      "s : "FAILED  "s) << name << std::endl;
+  }
+  return std::min(check::failures, 125);
+}
@@ -0,0 +1,252 @@
+//
+//  cspan_view_as.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/container/span/as_bytes
+//  @see: https://en.cppreference.com/w/cpp/memory/start_lifetime_as
+//  @see: https://en.cppreference.com/w/cpp/types/endian
+//
+
+#ifndef cspan_view_as_hpp
+#define cspan_view_as_hpp
+
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+
+namespace detail {
+
+template<std::size_t Size>
+struct uint_of_size;
+template<> struct uint_of_size<1U> { using type = std::uint8_t; };
+template<> struct uint_of_size<2U> { using type = std::uint16_t; };
+template<> struct uint_of_size<4U> { using type = std::uint32_t; };
+template<> struct uint_of_size<8U> { using type = std::uint64_t; };
+
+//  Types load_le / load_be / packed_view can byte-swap.
+template<class T>
+inline bool constexpr is_swappable_scalar_v
+  = (std::is_arithmetic_v<T> || std::is_enum_v<T>) && std::has_single_bit(sizeof(T)) && sizeof(T) <= 8U;
+
+template<class U>
+[[nodiscard]]
+constexpr U byteswap(U const value) noexcept {
+#if (defined(__cpp_lib_byteswap))
+  return std::byteswap(value);
+#else
+  if constexpr (sizeof(U) == 1U) {
+    return value;
+  }
+#if (defined(__GNUC__) || defined(__clang__))
+  else if constexpr (sizeof(U) == 2U) {
+    return __builtin_bswap16(value);
+  }
+  else if constexpr (sizeof(U) == 4U) {
+    return __builtin_bswap32(value);
+  }
+  else if constexpr (sizeof(U) == 8U) {
+    return __builtin_bswap64(value);
+  }
+#endif  /* (defined(__GNUC__) || defined(__clang__)) */
+  else {
+    U swapped { 0U };
+    for (std::size_t ix { 0U }; ix != sizeof(U); ++ix) {
+      swapped = static_cast<U>((swapped << 8U) | ((value >> (ix * 8U)) & 0xffU));
+    }
+    return swapped;
+  }
+#endif  /* (defined(__cpp_lib_byteswap)) */
+}
+
+//  sizeof(T) bytes at `src`, any alignment, in byte order `Order`.
+template<class T, std::endian Order>
+[[nodiscard]]
+inline T load(std::byte const * const src) noexcept {
+  if constexpr (Order == std::endian::native) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+  }
+  else {
+    static_assert(is_swappable_scalar_v<T>, "byte order conversion needs an arithmetic or enum type");
+    using U = typename uint_of_size<sizeof(T)>::type;
+    U raw;
+    std::memcpy(&raw, src, sizeof(U));
+    return std::bit_cast<T>(byteswap(raw));
+  }
+}
+
+[[noreturn]]
+inline void invalid_view(char const * const what) {
+  throw std::system_error { std::make_error_code(std::errc::invalid_argument), what };
+}
+
+} /* namespace detail */
+
+/*
+ *  MARK: view_as()
+ *  The inverse of std::as_bytes / std::as_writable_bytes: bytes viewed in
+ *  place as an array of T, nothing copied. The bytes must be aligned for
+ *  T and a whole number of T long, else std::system_error
+ *  (invalid_argument) is thrown; misaligned data needs packed_view.
+ *  Values are read in native byte order.
+ */
+template<class T, std::size_t N>
+[[nodiscard]]
+std::span<T const> view_as(std::span<std::byte const, N> const bytes) {
+  static_assert(std::is_trivially_copyable_v<T>, "view_as needs a trivially copyable T");
+  if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0U) {
+    detail::invalid_view("view_as: bytes misaligned for T");
+  }
+  if (bytes.size() % sizeof(T) != 0U) {
+    detail::invalid_view("view_as: size not a multiple of sizeof(T)");
+  }
+  auto const count = bytes.size() / sizeof(T);
+#if (defined(__cpp_lib_start_lifetime_as))
+  return { std::start_lifetime_as_array<T const>(bytes.data(), count), count };
+#else
+  return { reinterpret_cast<T const *>(bytes.data()), count };
+#endif  /* (defined(__cpp_lib_start_lifetime_as)) */
+}
+
+template<class T, std::size_t N>
+[[nodiscard]]
+std::span<T> view_as(std::span<std::byte, N> const bytes) {
+  auto const view = view_as<T>(std::span<std::byte const, N> { bytes });
+  return { const_cast<T *>(view.data()), view.size() };
+}
+
+/*
+ *  MARK: load_le(), load_be()
+ *  One T at byte `offset`, any alignment, converted from little- /
+ *  big-endian; T is an integer, enum or floating-point type.
+ */
+template<class T, std::size_t N>
+[[nodiscard]]
+inline T load_le(std::span<std::byte const, N> const bytes, std::size_t const offset = 0U) noexcept {
+  static_assert(detail::is_swappable_scalar_v<T>, "load_le needs an arithmetic or enum type");
+  assert(offset <= bytes.size() && sizeof(T) <= bytes.size() - offset);
+  return detail::load<T, std::endian::little>(bytes.data() + offset);
+}
+
+template<class T, std::size_t N>
+[[nodiscard]]
+inline T load_be(std::span<std::byte const, N> const bytes, std::size_t const offset = 0U) noexcept {
+  static_assert(detail::is_swappable_scalar_v<T>, "load_be needs an arithmetic or enum type");
+  assert(offset <= bytes.size() && sizeof(T) <= bytes.size() - offset);
+  return detail::load<T, std::endian::big>(bytes.data() + offset);
+}
+
+/*
+ *  MARK: packed_view
+ *  Records of T at any alignment, `stride` bytes apart (default
+ *  sizeof(T)): element ix is the T at byte ix * stride. With a stride
+ *  wider than T it views one field of a packed record array, e.g. the
+ *  uint32_t at offset 3 of 9-byte records is
+ *    packed_view<std::uint32_t> { bytes.subspan(3U), 9U }.
+ *  Elements are loaded by value (memcpy, then a byte swap when `Order`
+ *  is not native), so the view is read-only.
+ */
+template<class T, std::endian Order = std::endian::native>
+class packed_view {
+  static_assert(std::is_trivially_copyable_v<T>, "packed_view needs a trivially copyable T");
+
+public:
+  class iterator {
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T;
+
+    iterator() noexcept = default;
+    iterator(std::byte const * const base, std::size_t const stride, std::size_t const ix) noexcept
+      : base_ { base }, stride_ { stride }, ix_ { static_cast<difference_type>(ix) } {}
+
+    [[nodiscard]]
+    T operator*() const noexcept { return detail::load<T, Order>(base_ + static_cast<std::size_t>(ix_) * stride_); }
+    [[nodiscard]]
+    T operator[](difference_type const off) const noexcept { return *(*this + off); }
+
+    iterator & operator++() noexcept { ++ix_; return *this; }
+    iterator operator++(int) noexcept { auto const was = *this; ++ix_; return was; }
+    iterator & operator--() noexcept { --ix_; return *this; }
+    iterator operator--(int) noexcept { auto const was = *this; --ix_; return was; }
+    iterator & operator+=(difference_type const off) noexcept { ix_ += off; return *this; }
+    iterator & operator-=(difference_type const off) noexcept { ix_ -= off; return *this; }
+
+    [[nodiscard]]
+    friend iterator operator+(iterator it, difference_type const off) noexcept { return it += off; }
+    [[nodiscard]]
+    friend iterator operator+(difference_type const off, iterator it) noexcept { return it += off; }
+    [[nodiscard]]
+    friend iterator operator-(iterator it, difference_type const off) noexcept { return it -= off; }
+    [[nodiscard]]
+    friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept {
+      return lhs.ix_ - rhs.ix_;
+    }
+    [[nodiscard]]
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept { return lhs.ix_ == rhs.ix_; }
+    [[nodiscard]]
+    friend auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept { return lhs.ix_ <=> rhs.ix_; }
+
+  private:
+    std::byte const * base_ { nullptr };
+    std::size_t stride_ { sizeof(T) };
+    difference_type ix_ { 0 };
+  };
+
+  packed_view() noexcept = default;
+
+  //  As many whole records as fit: the last needs only sizeof(T) bytes.
+  template<std::size_t N>
+  explicit packed_view(std::span<std::byte const, N> const bytes, std::size_t const stride = sizeof(T)) noexcept
+    : data_ { bytes.data() }, stride_ { stride },
+      count_ { bytes.size() < sizeof(T) ? 0U : (bytes.size() - sizeof(T)) / stride + 1U } {
+    assert(stride != 0U);
+  }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept { return count_; }
+
+  [[nodiscard]]
+  bool empty() const noexcept { return count_ == 0U; }
+
+  [[nodiscard]]
+  std::size_t stride() const noexcept { return stride_; }
+
+  [[nodiscard]]
+  T operator[](std::size_t const ix) const noexcept {
+    assert(ix < count_);
+    return detail::load<T, Order>(data_ + ix * stride_);
+  }
+
+  [[nodiscard]]
+  iterator begin() const noexcept { return { data_, stride_, 0U }; }
+
+  [[nodiscard]]
+  iterator end() const noexcept { return { data_, stride_, count_ }; }
+
+private:
+  std::byte const * data_ { nullptr };
+  std::size_t stride_ { sizeof(T) };
+  std::size_t count_ { 0U };
+};
+
+} /* namespace cspan */
+
+#endif /* cspan_view_as_hpp */
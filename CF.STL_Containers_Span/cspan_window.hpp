@@ -0,0 +1,276 @@
+//
+//  cspan_window.hpp
+//  CF.STL_Containers_Span
+//
+//  MARK: - Reference.
+//  @see: https://en.cppreference.com/w/cpp/ranges/slide_view
+//  @see: https://en.cppreference.com/w/cpp/ranges/chunk_view
+//
+
+#ifndef cspan_window_hpp
+#define cspan_window_hpp
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+//  MARK: - namespace cspan
+//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
+namespace cspan {
+namespace detail {
+
+/*
+ *  MARK: index_iterator
+ *  Random access iterator over a sized range that can produce its
+ *  element `ix` directly. Holds the (small) range by value, so it
+ *  never dangles.
+ */
+template<class Range>
+class index_iterator {
+public:
+  using iterator_concept  = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+  using value_type        = typename Range::value_type;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = value_type;
+
+  constexpr index_iterator() = default;
+  constexpr index_iterator(Range const & range, std::size_t const ix) noexcept
+    : range_ { range }, ix_ { ix } {}
+
+  constexpr reference operator*() const noexcept { return range_[ix_]; }
+  constexpr reference operator[](difference_type const nr) const noexcept {
+    return range_[ix_ + static_cast<std::size_t>(nr)];
+  }
+
+  constexpr index_iterator & operator++() noexcept { ++ix_; return *this; }
+  constexpr index_iterator operator++(int) noexcept { auto tmp = *this; ++ix_; return tmp; }
+  constexpr index_iterator & operator--() noexcept { --ix_; return *this; }
+  constexpr index_iterator operator--(int) noexcept { auto tmp = *this; --ix_; return tmp; }
+
+  constexpr index_iterator & operator+=(difference_type const nr) noexcept {
+    ix_ += static_cast<std::size_t>(nr);
+    return *this;
+  }
+  constexpr index_iterator & operator-=(difference_type const nr) noexcept {
+    ix_ -= static_cast<std::size_t>(nr);
+    return *this;
+  }
+
+  friend constexpr index_iterator operator+(index_iterator it, difference_type const nr) noexcept {
+    return it += nr;
+  }
+  friend constexpr index_iterator operator+(difference_type const nr, index_iterator it) noexcept {
+    return it += nr;
+  }
+  friend constexpr index_iterator operator-(index_iterator it, difference_type const nr) noexcept {
+    return it -= nr;
+  }
+  friend constexpr difference_type operator-(index_iterator const & lhs,
+                                             index_iterator const & rhs) noexcept {
+    return static_cast<difference_type>(lhs.ix_) - static_cast<difference_type>(rhs.ix_);
+  }
+
+  friend constexpr bool operator==(index_iterator const & lhs,
+                                   index_iterator const & rhs) noexcept {
+    return lhs.ix_ == rhs.ix_;
+  }
+  friend constexpr auto operator<=>(index_iterator const & lhs,
+                                    index_iterator const & rhs) noexcept {
+    return lhs.ix_ <=> rhs.ix_;
+  }
+
+private:
+  Range range_ {};
+  std::size_t ix_ { 0U };
+};
+
+} /* namespace detail */
+
+/*
+ *  MARK: window_range
+ *  Equal-width subspans of a span, `stride` elements apart: the element
+ *  type is std::span<T, W>, so a compile-time width reaches the kernel
+ *  as a static extent. Size is known up front and element access is a
+ *  multiply-add; no bounds check per step.
+ */
+template<class T, std::size_t W = std::dynamic_extent>
+class window_range {
+public:
+  using value_type = std::span<T, W>;
+  using size_type  = std::size_t;
+  using iterator   = detail::index_iterator<window_range>;
+
+  constexpr window_range() = default;
+
+  constexpr window_range(T * data, size_type const count,
+                         size_type const width, size_type const stride) noexcept
+    : data_ { data }, width_ { width }, stride_ { stride }, count_ { count } {}
+
+  [[nodiscard]]
+  constexpr size_type size() const noexcept { return count_; }
+
+  [[nodiscard]]
+  constexpr bool empty() const noexcept { return count_ == 0U; }
+
+  [[nodiscard]]
+  constexpr size_type width() const noexcept {
+    if constexpr (W != std::dynamic_extent) {
+      return W;
+    }
+    else {
+      return width_;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr size_type stride() const noexcept { return stride_; }
+
+  [[nodiscard]]
+  constexpr value_type operator[](size_type const ix) const noexcept {
+    if constexpr (W != std::dynamic_extent) {
+      return value_type { data_ + ix * stride_, W };
+    }
+    else {
+      return value_type { data_ + ix * stride_, width_ };
+    }
+  }
+
+  [[nodiscard]]
+  constexpr value_type front() const noexcept { return (*this)[0U]; }
+
+  [[nodiscard]]
+  constexpr value_type back() const noexcept { return (*this)[count_ - 1U]; }
+
+  [[nodiscard]]
+  constexpr iterator begin() const noexcept { return iterator { *this, 0U }; }
+
+  [[nodiscard]]
+  constexpr iterator end() const noexcept { return iterator { *this, count_ }; }
+
+private:
+  T * data_ { nullptr };
+  size_type width_ { 0U };
+  size_type stride_ { 1U };
+  size_type count_ { 0U };
+};
+
+/*
+ *  MARK: chunk_range
+ *  Consecutive, non-overlapping subspans of `width` elements; the last
+ *  one holds the remainder and may be shorter.
+ */
+template<class T>
+class chunk_range {
+public:
+  using value_type = std::span<T>;
+  using size_type  = std::size_t;
+  using iterator   = detail::index_iterator<chunk_range>;
+
+  constexpr chunk_range() = default;
+
+  constexpr chunk_range(std::span<T> span, size_type const width) noexcept
+    : data_ { span.data() }, size_ { span.size() }, width_ { width } {}
+
+  [[nodiscard]]
+  constexpr size_type size() const noexcept {
+    return (size_ + width_ - 1U) / width_;
+  }
+
+  [[nodiscard]]
+  constexpr bool empty() const noexcept { return size_ == 0U; }
+
+  [[nodiscard]]
+  constexpr value_type operator[](size_type const ix) const noexcept {
+    auto const offset = ix * width_;
+    auto const rest = size_ - offset;
+    return value_type { data_ + offset, rest < width_ ? rest : width_ };
+  }
+
+  [[nodiscard]]
+  constexpr iterator begin() const noexcept { return iterator { *this, 0U }; }
+
+  [[nodiscard]]
+  constexpr iterator end() const noexcept { return iterator { *this, size() }; }
+
+private:
+  T * data_ { nullptr };
+  size_type size_ { 0U };
+  size_type width_ { 1U };
+};
+
+/*
+ *  MARK: exact_chunk_range
+ *  Only the full chunks; the leftover tail is available as remainder().
+ */
+template<class T, std::size_t W = std::dynamic_extent>
+class exact_chunk_range : public window_range<T, W> {
+public:
+  constexpr exact_chunk_range() = default;
+
+  constexpr exact_chunk_range(std::span<T> span, std::size_t const width) noexcept
+    : window_range<T, W> { span.data(), span.size() / width, width, width },
+      remainder_ { span.last(span.size() % width) } {}
+
+  [[nodiscard]]
+  constexpr std::span<T> remainder() const noexcept { return remainder_; }
+
+private:
+  std::span<T> remainder_ {};
+};
+
+//  MARK: windows()
+//  Every `width`-wide window, advancing by `stride`; [] if span is too short.
+//  Both must be non-zero (asserted); a zero stride that slips through a
+//  release build is taken as 1 rather than divided by.
+template<class T, std::size_t N>
+[[nodiscard]]
+constexpr auto windows(std::span<T, N> span, std::size_t const width,
+                       std::size_t stride = 1U) {
+  assert(width != 0U && stride != 0U);
+  stride = std::max<std::size_t>(stride, 1U);
+  auto const count = span.size() < width ? 0U : (span.size() - width) / stride + 1U;
+  return window_range<T> { span.data(), count, width, stride };
+}
+
+template<std::size_t W, class T, std::size_t N>
+[[nodiscard]]
+constexpr auto windows(std::span<T, N> span, std::size_t stride = 1U) {
+  static_assert(W != 0U && W != std::dynamic_extent);
+  assert(stride != 0U);
+  stride = std::max<std::size_t>(stride, 1U);
+  auto const count = span.size() < W ? 0U : (span.size() - W) / stride + 1U;
+  return window_range<T, W> { span.data(), count, W, stride };
+}
+
+//  MARK: chunks()
+//  `width` must be non-zero (asserted), here and in chunks_exact().
+template<class T, std::size_t N>
+[[nodiscard]]
+constexpr auto chunks(std::span<T, N> span, std::size_t const width) {
+  assert(width != 0U);
+  return chunk_range<T> { span, width };
+}
+
+//  MARK: chunks_exact()
+template<class T, std::size_t N>
+[[nodiscard]]
+constexpr auto chunks_exact(std::span<T, N> span, std::size_t const width) {
+  assert(width != 0U);
+  return exact_chunk_range<T> { span, width };
+}
+
+template<std::size_t W, class T, std::size_t N>
+[[nodiscard]]
+constexpr auto chunks_exact(std::span<T, N> span) {
+  static_assert(W != 0U && W != std::dynamic_extent);
+  return exact_chunk_range<T, W> { span, W };
+}
+
+} /* namespace cspan */
+
+#endif /* cspan_window_hpp */
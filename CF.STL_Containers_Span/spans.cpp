@@ -21,12 +21,26 @@
 #include <span>
 #include <array>
 #include <vector>
+#include <iterator>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <system_error>
+#if (__has_include(<memory_resource>))
+#include <memory_resource>
+#endif  /* (__has_include(<memory_resource>)) */
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #if (__cplusplus > 202002L)
 #include <ranges>
 #endif  /* (__cplusplus > 202002L) */
 
+#include "cspan.hpp"
+
 using namespace std::literals::string_literals;
 
 //  MARK: - Definitions
@@ -74,46 +88,11 @@ int main(int argc, const char * argv[]) {
 }
 
 //  MARK: - C_span
-//  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
-//  ================================================================================
-//  MARK: namespace cspan
-namespace cspan {
-
-template<class T, std::size_t N>
-[[nodiscard]]
-constexpr auto slide(std::span<T, N> span, std::size_t offset, std::size_t width) {
-  return span.subspan(offset, offset + width <= span.size() ? width : 0U);
-}
-
-template<class T, std::size_t N, std::size_t M>
-[[nodiscard]]
-constexpr bool starts_with(std::span<T, N> data, std::span<T, M> prefix) {
-  return data.size() >= prefix.size()
-  && std::equal(prefix.begin(), prefix.end(), data.begin());
-}
-
-template<class T, std::size_t N, std::size_t M>
-[[nodiscard]]
-constexpr bool ends_with(std::span<T, N> data, std::span<T, M> suffix) {
-  return data.size() >= suffix.size()
-    && std::equal(data.end() - suffix.size(), data.end(),
-                  suffix.end() - suffix.size());
-}
-
-template<class T, std::size_t N, std::size_t M>
-[[nodiscard]]
-constexpr bool contains(std::span<T, N> span, std::span<T, M> sub) {
-  return std::search(span.begin(), span.end(), sub.begin(),
-                     sub.end()) != span.end();
-}
-
-} /* namespace cspan */
-
 //  ....+....!....+....!....+....!....+....!....+....!....+....!....+....!....+....!
 /*
  *  MARK: C_span()
  */
-auto C_span(int argc, const char * argv[]) -> decltype(argc) {
+auto C_span(int argc, [[maybe_unused]] const char * argv[]) -> decltype(argc) {
   std::cout << "In "s << __func__ << std::endl;
 
   // ....+....!....+....!....+....!....+....!....+....!....+....!
@@ -130,12 +109,8 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
     int constexpr ary_a[] { 0, 1, 2, 3, 4, 5, 6, 7, 8, };
     int constexpr ary_b[] { 8, 7, 6, };
 
-    for (std::size_t offset{}; ; ++offset) {
-      std::size_t constexpr width{6};
-      auto sspan = cspan::slide(std::span { ary_a }, offset, width);
-        if (sspan.empty()) {
-        break;
-      }
+    std::size_t constexpr width{6};
+    for (auto const sspan : cspan::windows<width>(std::span { ary_a })) {
       print(sspan);
     }
 
@@ -156,6 +131,10 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
     [[maybe_unused]]
     auto t8 = cspan::contains(std::span { ary_a, 8 }, std::span { ary_a, 9 });
 
+#if (CSPAN_INSTRUMENT)
+    //  per-algorithm calls, matches and misses of the eight tests.
+    cspan::instrument::dump(std::cout);
+#else
     std::cout << std::boolalpha;
     std::cout << "test 1: "s << t1 << '\n'
               << "test 2: "s << t2 << '\n'
@@ -166,6 +145,7 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
               << "test 7: "s << t7 << '\n'
               << "test 8: "s << t8 << '\n';
     std::cout << std::noboolalpha;
+#endif  /* (CSPAN_INSTRUMENT) */
 
     static_assert(cspan::starts_with(std::span { ary_a }, std::span {ary_a, 4, })
         && cspan::starts_with(std::span { ary_a + 1, 4}, std::span{ ary_a + 1, 3 })
@@ -183,6 +163,707 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
     std::cout << '\n';
   }
 
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::contains, large spans"s << '\n';
+  {
+    auto const & ftr = cspan::cpu();
+    std::cout << std::boolalpha
+              << "sse2: "s << ftr.sse2 << ", sse4.2: "s << ftr.sse42
+              << ", avx2: "s << ftr.avx2 << '\n';
+
+    //  repetitive haystack: quadratic for a naive search.
+    std::vector<char> bytes(1U << 20U, 'a');
+    bytes.back() = 'b';
+    std::vector<char> needle(100U, 'a');
+    auto const t1 = cspan::contains(std::span { bytes }, std::span { needle });
+    needle.back() = 'b';
+    auto const t2 = cspan::contains(std::span { bytes }, std::span { needle });
+    needle.front() = 'b';
+    auto const t3 = cspan::contains(std::span { bytes }, std::span { needle });
+
+    std::vector<int> ints(1U << 16U);
+    std::iota(ints.begin(), ints.end(), 0);
+    auto const ispan = std::span<int const> { ints };
+    int constexpr short_needle[] { 40'000, 40'001, 40'002, };
+    int constexpr missing[] { 40'000, 40'002, };
+    auto const t4 = cspan::contains(ispan, std::span { short_needle });
+    auto const t5 = cspan::contains(ispan, std::span { missing });
+
+    std::cout << "test 1: "s << t1 << '\n'
+              << "test 2: "s << t2 << '\n'
+              << "test 3: "s << t3 << '\n'
+              << "test 4: "s << t4 << '\n'
+              << "test 5: "s << t5 << '\n';
+    std::cout << std::noboolalpha;
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::searcher"s << '\n';
+  {
+    std::string_view constexpr text { "abracadabra, abracadabra!" };
+    std::string_view constexpr word { "abra" };
+
+    auto const search = cspan::searcher<char> { std::span { word } };
+    std::array<std::size_t, 8> offsets;
+
+    std::cout << std::boolalpha
+              << "contains:   "s << search.contains(std::span { text }) << '\n'
+              << "find_first: "s << search.find_first(std::span { text }) << '\n'
+              << "count:      "s << search.count(std::span { text }) << '\n'
+              << "find_all:   "s;
+    for (auto const offset : search.find_all(std::span { text }, offsets)) {
+      std::cout << offset << ' ';
+    }
+    std::cout << std::noboolalpha << '\n';
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::multi_searcher"s << '\n';
+  {
+    std::string_view constexpr text { "ushers and his hers she said" };
+    std::string_view constexpr words[] { "he", "she", "his", "hers", };
+
+    auto const search = cspan::multi_searcher<char> {
+      std::span { words[0] }, std::span { words[1] },
+      std::span { words[2] }, std::span { words[3] },
+    };
+
+    std::cout << "states: "s << search.states() << '\n';
+    search.for_each_match(std::span { text }, [&](auto const & found) {
+      std::cout << std::setw(2) << found.offset << ": "s
+                << words[found.pattern] << '\n';
+      return true;
+    });
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::windows, cspan::chunks, cspan::chunks_exact"s << '\n';
+  {
+    auto print = [](std::string_view const title, auto const & range) {
+      std::cout << title << '[' << range.size() << "]:"s;
+      for (auto const sub : range) {
+        std::cout << " {"s;
+        for (auto const elem : sub) {
+          std::cout << ' ' << elem;
+        }
+        std::cout << " }"s;
+      }
+      std::cout << '\n';
+    };
+
+    int constexpr ary[] { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, };
+
+    print("windows(3, 2)    "s, cspan::windows(std::span { ary }, 3, 2));
+    print("windows<4>(3)    "s, cspan::windows<4>(std::span { ary }, 3));
+    print("chunks(4)        "s, cspan::chunks(std::span { ary }, 4));
+    auto const exact = cspan::chunks_exact<4>(std::span { ary });
+    print("chunks_exact<4>  "s, exact);
+    std::cout << "remainder: "s << exact.remainder().size() << '\n';
+
+    static_assert(cspan::windows<4>(std::span { ary }, 3).size() == 3);
+    static_assert(cspan::windows<4>(std::span { ary }, 3)[2].back() == 9);
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::rolling_sum, rolling_min, rolling_max, rolling_mean"s << '\n';
+  {
+    auto print = [](std::string_view const title, auto const & seq) {
+      cspan::format_buffer out { cspan::thread_format_storage() };
+      cspan::format_to(out.append(title), std::span { seq }, {
+        .width = 6U, .separator = "", .close = "\n",
+      });
+    };
+
+    int constexpr samples[] { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8, };
+    std::size_t constexpr width { 4U };
+    std::array<int, std::size(samples)> ints;
+    std::array<double, std::size(samples)> means;
+
+    print("samples: "s, samples);
+    print("sum:     "s, cspan::rolling_sum(std::span { samples }, width, std::span { ints }));
+    print("min:     "s, cspan::rolling_min(std::span { samples }, width, std::span { ints }));
+    print("max:     "s, cspan::rolling_max(std::span { samples }, width, std::span { ints }));
+    print("mean:    "s, cspan::rolling_mean(std::span { samples }, width, std::span { means }));
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::fill, copy, equal, reverse, rotate, sum, min_max"s << '\n';
+  {
+    auto print = [](std::string_view const title, auto const & seq) {
+      std::cout << title;
+      for (auto const & elem : seq) {
+        std::cout << ' ' << elem;
+      }
+      std::cout << '\n';
+    };
+
+    //  static extent: unrolled at compile time.
+    std::array<int, 8> fixed;
+    cspan::fill(std::span { fixed }, 7);
+    print("fill:     "s, fixed);
+    int constexpr digits[] { 3, 1, 4, 1, 5, 9, 2, 6, };
+    cspan::copy(std::span { digits }, std::span { fixed });
+    cspan::reverse(std::span { fixed });
+    print("reverse:  "s, fixed);
+    cspan::rotate(std::span { fixed }, 3);
+    print("rotate 3: "s, fixed);
+    auto const [lo, hi] = cspan::min_max(std::span { fixed });
+    std::cout << std::boolalpha
+              << "equal:    "s << cspan::equal(std::span { fixed }, std::span { digits }) << '\n'
+              << "sum:      "s << cspan::sum(std::span { fixed }) << '\n'
+              << "min_max:  "s << lo << ' ' << hi << '\n';
+
+    //  dynamic extent: tuned runtime loops.
+    std::vector<double> values(1'000U);
+    std::iota(values.begin(), values.end(), 0.5);
+    auto const span = std::span<double const> { values };
+    auto const [vlo, vhi] = cspan::min_max(span);
+    std::cout << "dynamic:  sum "s << cspan::sum(span)
+              << ", min "s << vlo << ", max "s << vhi
+              << ", equal "s << cspan::equal(span, span.first(999U)) << '\n';
+    std::cout << std::noboolalpha;
+
+    static_assert(cspan::sum(std::span { digits }) == 31);
+    static_assert(cspan::min_max(std::span { digits }).max == 9);
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::sorted, unique, binary_search, static_set"s << '\n';
+  {
+    //  Tables built entirely at compile time.
+    static int constexpr raw[] { 5, 3, 9, 3, 1, 5, 7, 9, 2, };
+    static auto constexpr order = cspan::sorted(std::span { raw });
+    static cspan::static_set constexpr set { std::span { raw } };
+
+    std::cout << "sorted:   "s;
+    for (auto const elem : order) {
+      std::cout << ' ' << elem;
+    }
+    std::cout << "\nset:      "s;
+    for (auto const elem : set) {
+      std::cout << ' ' << elem;
+    }
+    std::cout << std::boolalpha
+              << "\ncontains: 7 "s << set.contains(7) << ", 4 "s << set.contains(4) << '\n'
+              << std::noboolalpha;
+
+    static_assert(cspan::binary_search(std::span { order }, 9));
+    static_assert(cspan::lower_bound(std::span { order }, 4) == 4U);
+    static_assert(set.size() == 6U && set.find(7) == 4U && !set.contains(8));
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::eytzinger_index, cspan::static_btree"s << '\n';
+  {
+    //  multiples of 3: 0, 3, ..., 2997.
+    std::vector<int> sorted(1'000U);
+    std::generate(sorted.begin(), sorted.end(), [n = 0]() mutable { return 3 * n++; });
+    auto const span = std::span<int const> { sorted };
+
+    cspan::eytzinger_index const eytzinger { span };
+    cspan::static_btree const btree { span };
+
+    int constexpr queries[] { -5, 0, 1, 299, 300, 1'500, 2'997, 2'998, };
+    std::array<std::size_t, std::size(queries)> ranks;
+    btree.lower_bound(std::span { queries }, std::span { ranks });
+
+    auto agree { true };
+    std::cout << "lower_bound:"s;
+    for (std::size_t ix { 0U }; ix != std::size(queries); ++ix) {
+      auto const expect = static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), queries[ix])
+                                                   - sorted.begin());
+      agree = agree && eytzinger.lower_bound(queries[ix]) == expect && ranks[ix] == expect;
+      std::cout << ' ' << queries[ix] << " -> "s << ranks[ix] << ';';
+    }
+    std::cout << std::boolalpha
+              << "\nsame as std::lower_bound: "s << agree << '\n'
+              << std::noboolalpha;
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::filter, cspan::filter_reverse"s << '\n';
+  {
+    //  the "std::span, rbegin" demo, without reverse iterators.
+    std::span<char const> constexpr code { "@droNE_T0P_w$s@s#_SECRET_a,p^42!" };
+    std::array<char, code.size()> buffer;
+    auto const found = cspan::filter_reverse(code, std::span { buffer },
+                                             cspan::in_range { 'a', '\x7f' });
+    std::cout << "filter_reverse: "s
+              << std::string_view { found.data(), found.size() } << '\n';
+
+    int constexpr samples[] { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8, };
+    std::array<int, std::size(samples)> kept;
+    std::cout << "filter odd:     "s;
+    for (auto const elem : cspan::filter(std::span { samples }, std::span { kept },
+                                         [](int const val) { return val % 2 != 0; })) {
+      std::cout << elem << ' ';
+    }
+    std::cout << '\n';
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::par::contains, count, transform, reduce, for_each_window"s << '\n';
+  {
+    std::vector<int> values(1U << 20U);
+    std::iota(values.begin(), values.end(), 0);
+    int constexpr needle[] { 700'000, 700'001, };
+    std::vector<long> squares(values.size());
+
+    auto const span = std::span<int const> { values };
+    std::atomic<std::size_t> rising { 0U };
+    cspan::par::transform(span, std::span { squares }, [](int const val) { return long { val } * val; });
+    cspan::par::for_each_window(span, 3U, [&rising](std::span<int const> const win) {
+      rising += win[0] < win[1] && win[1] < win[2] ? 1U : 0U;
+    });
+
+    std::cout << std::boolalpha
+              << "threads:         "s << cspan::par::default_pool().size() << '\n'
+              << "contains:        "s << cspan::par::contains(span, std::span { needle }) << '\n'
+              << "count:           "s << cspan::par::count(span, std::span { needle }) << '\n'
+              << "reduce:          "s << cspan::par::reduce(span, 0L, std::plus<> {}) << '\n'
+              << "squares.back():  "s << squares.back() << '\n'
+              << "rising windows:  "s << rising.load() << '\n'
+              << std::noboolalpha;
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::arena, arena_scope, arena_resource"s << '\n';
+  {
+    //  first 1 KiB from the stack, then 4 KiB heap blocks.
+    alignas(64) std::byte stack[1'024];
+    cspan::arena scratch { std::span { stack }, 4U << 10U };
+
+    auto const base = scratch.allocate_span<int>(8U);
+    std::iota(base.begin(), base.end(), 1);
+    {
+      cspan::arena_scope const scope { scratch };
+      auto const lanes = scratch.allocate_span<float>(16U, 64U);
+      auto const copy = scratch.copy_span(std::span<int const> { base });
+      cspan::reverse(copy);
+      std::cout << "lanes aligned: "s << std::boolalpha
+                << (reinterpret_cast<std::uintptr_t>(lanes.data()) % 64U == 0U)
+                << std::noboolalpha << '\n'
+                << "copy:          "s;
+      for (auto const val : copy) {
+        std::cout << std::setw(3) << val;
+      }
+      std::cout << '\n';
+      static_cast<void>(scratch.allocate_span<char>(2'000U));
+      std::cout << "capacity:      "s << scratch.capacity() << '\n';
+    }
+
+#if (defined(__cpp_lib_memory_resource))
+    cspan::arena_resource resource { scratch };
+    std::pmr::vector<int> pvec { &resource };
+    for (int ix { 0 }; ix != 5; ++ix) {
+      pvec.push_back(ix * ix);
+    }
+    std::cout << "pmr::vector:   "s;
+    for (auto const val : pvec) {
+      std::cout << std::setw(3) << val;
+    }
+    std::cout << '\n';
+#endif  /* (defined(__cpp_lib_memory_resource)) */
+
+    std::cout << "base sum:      "s << cspan::sum(std::span<int const> { base }) << '\n';
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::view_as, load_le, load_be, packed_view"s << '\n';
+  {
+    //  as_bytes and back again: same storage, nothing copied.
+    std::array<std::uint16_t, 4> ary { 0x0102U, 0x0304U, 0x0506U, 0x0708U, };
+    auto const bytes = std::as_bytes(std::span { ary });
+    auto const words = cspan::view_as<std::uint16_t>(bytes);
+    std::cout << "same data: "s << std::boolalpha << (words.data() == ary.data())
+              << std::noboolalpha << '\n'
+              << std::hex << std::setfill('0')
+              << "load_le:   "s << std::setw(8) << cspan::load_le<std::uint32_t>(bytes, 2U) << '\n'
+              << "load_be:   "s << std::setw(8) << cspan::load_be<std::uint32_t>(bytes, 2U) << '\n'
+              << std::dec << std::setfill(' ');
+
+    //  5-byte wire records { uint8_t tag; uint32_t big-endian id; }.
+    alignas(4) std::byte constexpr wire[] {
+      std::byte { 'a' }, std::byte { 0x00 }, std::byte { 0x00 }, std::byte { 0x01 }, std::byte { 0x00 },
+      std::byte { 'b' }, std::byte { 0x00 }, std::byte { 0x00 }, std::byte { 0x02 }, std::byte { 0x00 },
+      std::byte { 'c' }, std::byte { 0x00 }, std::byte { 0x01 }, std::byte { 0x00 }, std::byte { 0x01 },
+    };
+    auto const records = std::span<std::byte const> { wire };
+    cspan::packed_view<char> const tags { records, 5U };
+    cspan::packed_view<std::uint32_t, std::endian::big> const ids { records.subspan(1U), 5U };
+    for (std::size_t ix { 0U }; ix != ids.size(); ++ix) {
+      std::cout << tags[ix] << ": "s << std::setw(6) << ids[ix] << '\n';
+    }
+
+    try {
+      static_cast<void>(cspan::view_as<std::uint32_t>(records.subspan(1U, 4U)));
+    }
+    catch (std::system_error const & ex) {
+      std::cout << "misaligned: "s << ex.code().message() << '\n';
+    }
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::strided_span, cspan::span2d, transpose, for_each_tile"s << '\n';
+  {
+    //  the subspan sliding grid, as a view: row r starts one letter on.
+    char abc[26];
+    std::iota(std::begin(abc), std::end(abc), 'A');
+    cspan::span2d<char const> const grid { abc, 7U, 20U, 1U, 1U };
+    for (std::size_t row { 0U }; row != grid.rows(); ++row) {
+      auto const line = grid.row_span(row);
+      std::cout << std::string_view { line.data(), line.size() } << '\n';
+    }
+    std::cout << "column 19:  "s;
+    for (auto const chr : grid.col(19U)) {
+      std::cout << chr;
+    }
+    std::cout << '\n';
+
+    std::array<int, 12> flat;
+    std::iota(flat.begin(), flat.end(), 0);
+    std::array<int, 12> flipped;
+    cspan::span2d<int const> const mat { std::span<int const> { flat }, 3U, 4U };
+    cspan::span2d<int> const tmat { std::span { flipped }, 4U, 3U };
+    cspan::transpose(mat, tmat);
+    for (std::size_t row { 0U }; row != tmat.rows(); ++row) {
+      std::cout << "transposed: "s;
+      for (auto const val : tmat.row(row)) {
+        std::cout << std::setw(3) << val;
+      }
+      std::cout << '\n';
+    }
+
+    cspan::for_each_tile(mat, 2U, 3U, [](auto const tile, std::size_t const row, std::size_t const col) {
+      std::cout << "tile ("s << row << ", "s << col << ") "s
+                << tile.rows() << 'x' << tile.cols() << ": "s << tile(0U, 0U) << '\n';
+    });
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::soa, aos_to_soa, soa_to_aos"s << '\n';
+  {
+    struct planet {
+      char const * name;
+      double mass;     //  Earth masses
+      double radius;   //  Earth radii
+    };
+    std::array<planet, 4> const inner {
+      planet { "Mercury", 0.055, 0.383, },
+      planet { "Venus",   0.815, 0.949, },
+      planet { "Earth",   1.000, 1.000, },
+      planet { "Mars",    0.107, 0.532, },
+    };
+
+    cspan::soa<char const *, double, double> planets;
+    cspan::aos_to_soa(std::span { inner }, planets, &planet::name, &planet::mass, &planet::radius);
+    planets.push_back("Ceres", 0.00016, 0.074);
+
+    //  one column is one std::span: the cspan algorithms apply as-is.
+    auto const [lightest, heaviest] = cspan::min_max(planets.column<1>());
+    std::cout << "planets:     "s << planets.size() << '\n'
+              << "total mass:  "s << cspan::sum(planets.column<1>()) << '\n'
+              << "mass range:  "s << lightest << " .. "s << heaviest << '\n';
+
+    for (auto [name, mass, radius] : planets.rows()) {
+      std::cout << std::setw(8) << name << ": density "s
+                << std::setprecision(3) << mass / (radius * radius * radius) << '\n';
+    }
+
+    std::array<planet, 5> round_trip {};
+    cspan::soa_to_aos(planets, std::span { round_trip }, &planet::name, &planet::mass, &planet::radius);
+    std::cout << "round trip:  "s << round_trip.back().name << '\n'
+              << std::setprecision(6);
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::hash, hasher, crc32c, content_chunks"s << '\n';
+  {
+    std::string_view constexpr check { "123456789" };
+    auto const check_bytes = std::as_bytes(std::span { check });
+    std::cout << std::hex << std::setfill('0')
+              << "crc32c(\"123456789\"): "s << std::setw(8) << cspan::crc32c(check_bytes) << '\n'
+              << std::dec << std::setfill(' ');
+
+    //  pseudo-random "file" contents, then the same with 3 bytes inserted.
+    std::vector<std::byte> file(64U << 10U);
+    std::uint32_t state { 1U };
+    std::generate(file.begin(), file.end(), [&state] {
+      state = state * 1'103'515'245U + 12'345U;
+      return static_cast<std::byte>(state >> 24U);
+    });
+    auto edited = file;
+    std::byte const patch[] { std::byte { 'c' }, std::byte { 'f' }, std::byte { 'x' }, };
+    edited.insert(edited.begin() + 20'000, std::begin(patch), std::end(patch));
+
+    cspan::hasher streamed;
+    streamed.update_each(cspan::chunks(std::span<std::byte const> { file }, 1'000U));
+    std::cout << std::boolalpha
+              << "streamed == one-shot: "s
+              << (streamed.digest() == cspan::hash(std::span<std::byte const> { file })) << '\n'
+              << std::noboolalpha;
+
+    cspan::chunk_options constexpr small { .min_size = 1U << 10U, .avg_size = 4U << 10U, .max_size = 16U << 10U, };
+    std::vector<std::uint64_t> seen;
+    for (auto const chunk : cspan::content_chunks(std::span<std::byte const> { file }, small)) {
+      seen.push_back(cspan::hash(chunk));
+    }
+    std::size_t chunks { 0U };
+    std::size_t reused { 0U };
+    for (auto const chunk : cspan::content_chunks(std::span<std::byte const> { edited }, small)) {
+      ++chunks;
+      reused += std::find(seen.begin(), seen.end(), cspan::hash(chunk)) != seen.end() ? 1U : 0U;
+    }
+    std::cout << "chunks before edit:   "s << seen.size() << '\n'
+              << "unchanged after edit: "s << reused << " of "s << chunks << '\n';
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::pipeline: map, filter, windows"s << '\n';
+  {
+    int constexpr ary[] { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, };
+    auto const odd_squares = cspan::pipeline { std::span { ary } }
+      .map([](int const val) { return val * val; })
+      .filter([](int const val) { return val % 2 != 0; });
+
+    std::cout << "odd squares:       "s;
+    odd_squares.for_each([](int const val) { std::cout << std::setw(4) << val; });
+    std::cout << '\n'
+              << "3-wide window sums:"s;
+    odd_squares
+      .windows(3U, [](std::span<int const> const win) { return cspan::sum(win); })
+      .for_each([](int const val) { std::cout << std::setw(4) << val; });
+    std::cout << '\n'
+              << "count, sum:        "s << odd_squares.count() << ", "s << odd_squares.sum() << '\n';
+
+    //  the rbegin demo's copy_if, fused into one pass then reversed.
+    std::string_view constexpr code { "@droNE_T0P_w$s@s#_SECRET_a,p^42!" };
+    std::array<char, code.size()> plain;
+    auto const kept = cspan::pipeline { std::span { code } }
+      .filter([](unsigned const chr) { return chr - 0141 < 120; })
+      .collect(std::span { plain });
+    cspan::reverse(kept);
+    std::cout << "decoded:           "s << std::string_view { kept.data(), kept.size() } << '\n';
+
+    std::cout << '\n';
+  }
+
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::inline_buffer"s << '\n';
+  {
+    //  ary_a and ary_b as they would arrive at run time: parsed into
+    //  inline storage, no heap allocation up to 16 elements.
+    auto parse = [](std::string const & text) {
+      cspan::inline_buffer<int, 16> values;
+      std::istringstream in { text };
+      for (int val; in >> val;) {
+        values.push_back(val);
+      }
+      return values;
+    };
+    auto const seq_a = parse("0 1 2 3 4 5 6 7 8"s);
+    auto const seq_b = parse("8 7 6"s);
+    auto const seq_z = parse("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19"s);
+
+    auto show = [](std::string_view const name, auto const & seq) {
+      std::cout << name << ": size "s << std::setw(2) << seq.size()
+                << ", capacity "s << std::setw(2) << seq.capacity()
+                << (seq.is_inline() ? ", inline"s : ", spilled"s) << '\n';
+    };
+    show("seq_a"s, seq_a);
+    show("seq_b"s, seq_b);
+    show("seq_z"s, seq_z);
+
+    //  std::span<int const> straight from the buffers.
+    std::cout << std::boolalpha
+              << "ends_with(seq_a, { 7, 8 }):   "s
+              << cspan::ends_with(std::span<int const> { seq_a }, std::span<int const> { seq_a }.last(2U)) << '\n'
+              << "contains(seq_z, seq_a):      "s
+              << cspan::contains(std::span<int const> { seq_z }, std::span<int const> { seq_a }) << '\n'
+              << "starts_with(seq_a, seq_b):   "s
+              << cspan::starts_with(std::span<int const> { seq_a }, std::span<int const> { seq_b }) << '\n'
+              << std::noboolalpha;
+
+    std::cout << '\n';
+  }
+
+#if (CSPAN_HAS_MMAP)
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::mapped_file, cspan::mapped_span"s << '\n';
+  {
+    auto const path = std::filesystem::temp_directory_path() / "cspan_mapped_demo.bin";
+    {
+      std::array<int, 10> ary;
+      std::iota(ary.begin(), ary.end(), 0);
+      std::ofstream { path, std::ios::binary }
+        .write(reinterpret_cast<char const *>(ary.data()), sizeof(ary));
+    }
+
+    {
+      //  zero-copy: the span points into the page cache.
+      cspan::mapped_span<int> const ints { path, { .advice = cspan::map_advice::sequential, } };
+      int constexpr needle[] { 4, 5, 6, };
+      std::cout << "size:     "s << ints.size() << '\n'
+                << std::boolalpha
+                << "contains: "s << cspan::contains(ints.span(), std::span { needle }) << '\n'
+                << std::noboolalpha
+                << "sum:      "s << cspan::sum(ints.span()) << '\n';
+
+      //  copy-on-write: private pages, the file is unchanged.
+      cspan::mapped_span<int> cow { path, { .mode = cspan::map_mode::copy_on_write, } };
+      cow.writable_span()[0] = 42;
+      std::cout << "cow[0]:   "s << cow.span()[0]
+                << ", file[0]: "s << ints.span()[0] << '\n';
+    }
+    std::filesystem::remove(path);
+
+    std::cout << '\n';
+  }
+#endif  /* (CSPAN_HAS_MMAP) */
+
+#if (CSPAN_HAS_MMAP)
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::ring: reserve / commit, peek / release"s << '\n';
+  {
+    //  batches written and read in place: no vector per hand-off.
+    cspan::ring<int> queue { 256U };
+    std::size_t constexpr batches { 100U };
+    std::size_t constexpr batch { 8U };
+    std::thread producer { [&queue] {
+      for (std::size_t ix { 0U }; ix != batches; ++ix) {
+        auto out = queue.reserve(batch);
+        for (; out.empty(); out = queue.reserve(batch)) {
+          std::this_thread::yield();
+        }
+        std::iota(out.begin(), out.end(), static_cast<int>(ix * batch));
+        queue.commit(out);
+      }
+    } };
+
+    long total { 0L };
+    std::size_t seen { 0U };
+    while (seen != batches * batch) {
+      auto const in = queue.peek();
+      if (in.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+      total = std::accumulate(in.begin(), in.end(), total);
+      seen += in.size();
+      queue.release(in);
+    }
+    producer.join();
+    std::cout << "capacity: "s << queue.capacity()
+              << ", received: "s << seen << ", sum: "s << total << '\n';
+
+    //  a region across the end of the buffer is still one span.
+    auto const skip = queue.capacity() - seen % queue.capacity() - 3U;
+    std::vector<int> filler(skip);
+    static_cast<void>(queue.push(filler));
+    static_cast<void>(queue.pop(filler));
+    auto const out = queue.reserve(8U);
+    std::iota(out.begin(), out.end(), 1);
+    queue.commit(out);
+    auto const in = queue.peek();
+    std::cout << "wrapped at "s << queue.capacity() - 3U << ": "s;
+    for (auto const val : in) {
+      std::cout << val << ' ';
+    }
+    std::cout << '\n';
+    queue.release(in);
+
+    std::cout << '\n';
+  }
+#endif  /* (CSPAN_HAS_MMAP) */
+
+#if (CSPAN_HAS_STREAM_READER)
+  // ....+....!....+....!....+....!....+....!....+....!....+....!
+  std::cout << konst::dot << '\n';
+  std::cout << "cspan::stream_reader"s << '\n';
+  {
+    //  a pipe cannot be mapped: stream it in 64-byte chunks instead.
+    std::string text;
+    for (int ix { 0 }; ix != 40; ++ix) {
+      text += "the quick brown fox jumps over the lazy dog. "s;
+    }
+    std::string_view constexpr word { "lazy dog" };
+
+    int fds[2];
+    if (::pipe(fds) == 0) {
+      std::thread writer { [&text, fd = fds[1]] {
+        static_cast<void>(::write(fd, text.data(), text.size()));
+        ::close(fd);
+      } };
+
+      auto const search = cspan::searcher<std::byte> { std::as_bytes(std::span { word }) };
+      cspan::stream_reader reader { fds[0], { .chunk_size = 64U, .overlap = word.size() - 1U, } };
+      std::size_t chunks { 0U };
+      std::size_t found { 0U };
+      for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next()) {
+        ++chunks;
+        found += search.count(chunk);
+      }
+      writer.join();
+      ::close(fds[0]);
+
+      std::cout << "chunks:    "s << chunks << '\n'
+                << "streamed:  "s << found << '\n'
+                << "in memory: "s << cspan::searcher<char> { std::span { word } }.count(std::span { text }) << '\n';
+    }
+
+    std::cout << '\n';
+  }
+#endif  /* (CSPAN_HAS_STREAM_READER) */
+
   // ....+....!....+....!....+....!....+....!....+....!....+....!
   std::cout << konst::dot << '\n';
   std::cout << "std::span, operator="s << '\n';
@@ -345,18 +1026,18 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
 #define UTF16_
 #if (defined(UTF8_))
     [[maybe_unused]]
-    std::string_view constexpr bars[] = {
+    static std::string_view constexpr bars[] = {
       "\xE2\x96\x81", "\xE2\x96\x82", "\xE2\x96\x83", "\xE2\x96\x84",
       "\xE2\x96\x85", "\xE2\x96\x86", "\xE2\x96\x87", "\xE2\x96\x88",
     };
 #elif (defined(UTF16_))
     [[maybe_unused]]
-    std::string_view constexpr bars[] = {
+    static std::string_view constexpr bars[] = {
       "\u2581", "\u2582", "\u2583", "\u2584", "\u2585", "\u2586", "\u2587", "\u2588",
     };
 #else   /* (!defined(UTF8) && !defined(UTF16)) */
     [[maybe_unused]]
-    std::string_view constexpr bars[] = {
+    static std::string_view constexpr bars[] = {
       "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█",
     };
 #endif  /* (!defined(UTF8) && !defined(UTF16)) */
@@ -364,6 +1045,24 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
     ascending(bars, " "s);
     descending(bars, "\n"s);
 
+    //  The same table as a perfect hash, built at compile time:
+    //  glyph -> level, no runtime initialisation.
+    static constexpr cspan::perfect_hash levels { std::span { bars } };
+    static_assert(levels.find(bars[3]) == 3U);
+    static_assert(!levels.contains(std::string_view { "#" }));
+
+    for (auto const glyph : { bars[5], bars[0], std::string_view { "#" }, }) {
+      auto const level = levels.find(glyph);
+      std::cout << glyph << " -> "s;
+      if (level != levels.npos) {
+        std::cout << level << ' ';
+      }
+      else {
+        std::cout << "none "s;
+      }
+    }
+    std::cout << '\n';
+
     std::cout << '\n';
   }
 
@@ -609,12 +1308,12 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
   std::cout << "std::std::as_bytes, std::as_writable_bytes"s << '\n';
   {
     auto print = [](float const x_val, std::span<std::byte const> const bytes) {
-      std::cout << std::setprecision(6) << std::setw(8) << x_val << " = { "s
-                << std::hex << std::uppercase << std::setfill('0');
-      for (auto const b_ : bytes) {
-        std::cout << std::setw(2) << std::to_integer<int>(b_) << ' ';
-      }
-      std::cout << std::dec << "}\n"s;
+      cspan::format_buffer out { cspan::thread_format_storage() };
+      out.append(x_val, { .width = 8U, .precision = 6, });
+      cspan::format_to(out, bytes, {
+        .base = cspan::base::hex, .uppercase = true, .width = 2U, .fill = '0',
+        .open = " = { ", .close = " }\n",
+      });
     };
 
     /* mutable */ float data[1] { 3.141592f };
@@ -679,7 +1378,7 @@ auto C_span(int argc, const char * argv[]) -> decltype(argc) {
 /*
  *  MARK: C_span_deduction_guides()
  */
-auto C_span_deduction_guides(int argc, const char * argv[]) -> decltype(argc) {
+auto C_span_deduction_guides(int argc, [[maybe_unused]] const char * argv[]) -> decltype(argc) {
   std::cout << "In "s << __func__ << std::endl;
 
   // ....+....!....+....!....+....!....+....!....+....!....+....!
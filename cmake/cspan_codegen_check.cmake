@@ -0,0 +1,85 @@
+#
+#  cspan_codegen_check.cmake
+#  CF.STL_Containers_Span
+#
+#  Compile the cspan_codegen.cpp probes to assembly and fail if a
+#  static-extent probe_* function is not straight-line code: it may not
+#  branch back to one of its own labels, nor call or jump out to a function
+#  that could hold the loop. The probe_*_dynamic functions are exempt, and
+#  at least one backward branch must turn up somewhere in the file, so a
+#  change in assembly syntax cannot make the check pass vacuously.
+#
+#    cmake -DCXX=c++ -DSOURCE=cspan_codegen.cpp -DINCLUDE=<dir> -DOUTPUT=<file.s>
+#          -P cspan_codegen_check.cmake
+#
+
+cmake_minimum_required(VERSION 3.20)
+
+foreach (required CXX SOURCE INCLUDE OUTPUT)
+  if (NOT DEFINED ${required})
+    message(FATAL_ERROR "cspan_codegen_check: -D${required}=... is required")
+  endif ()
+endforeach ()
+
+execute_process(
+  COMMAND ${CXX} -std=c++20 -O2 -I${INCLUDE} -S -o ${OUTPUT} ${SOURCE}
+  RESULT_VARIABLE status
+  ERROR_VARIABLE diagnostics)
+if (NOT status EQUAL 0)
+  message(FATAL_ERROR "cspan_codegen_check: compiling ${SOURCE} failed\n${diagnostics}")
+endif ()
+
+#  x86 jcc / jmp / loop, AArch64 b / b.cond / cb(n)z / tb(n)z, ARM bcond.
+set(branch_ops "^(j[a-z]+|loop[a-z]*|b|b[.]?(eq|ne|cs|hs|cc|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le)|cbn?z|tbn?z)$")
+set(call_ops "^(call|callq|bl|blr)$")
+set(local_label "[.]?L[A-Za-z0-9_$.]+")
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+set(labels "")
+set(backward 0)
+set(failures "")
+foreach (line IN LISTS lines)
+  if (line MATCHES "^(${local_label}):")
+    list(APPEND labels ${CMAKE_MATCH_1})
+  elseif (line MATCHES "^_?([A-Za-z_][A-Za-z0-9_$]*):")
+    set(function ${CMAKE_MATCH_1})
+    set(labels "")
+  elseif (line MATCHES "[.]cfi_endproc")
+    set(function "")
+  elseif (function AND line MATCHES "^[ \t]+([a-z][a-z.]*)[ \t]*(.*)$")
+    set(op ${CMAKE_MATCH_1})
+    set(operands ${CMAKE_MATCH_2})
+    set(straight_line FALSE)
+    if (function MATCHES "^probe_" AND NOT function MATCHES "_dynamic")
+      set(straight_line TRUE)
+    endif ()
+    if (op MATCHES "${branch_ops}")
+      set(target "")
+      if (operands MATCHES "(^|[ \t,])(${local_label})[ \t]*$")
+        set(target ${CMAKE_MATCH_2})
+      endif ()
+      if (NOT target)
+        if (straight_line)
+          list(APPEND failures "${function}: jumps out `${op} ${operands}`")
+        endif ()
+      elseif (target IN_LIST labels)
+        math(EXPR backward "${backward} + 1")
+        if (straight_line)
+          list(APPEND failures "${function}: backward branch `${op} ${operands}`")
+        endif ()
+      endif ()
+    elseif (straight_line AND op MATCHES "${call_ops}")
+      list(APPEND failures "${function}: calls `${op} ${operands}`")
+    endif ()
+  endif ()
+endforeach ()
+
+if (backward EQUAL 0)
+  list(APPEND failures "no backward branch anywhere in ${OUTPUT}: the assembly was not understood")
+endif ()
+if (failures)
+  list(JOIN failures "\n  " report)
+  message(FATAL_ERROR "cspan_codegen_check: fixed-extent probes are not straight-line code\n  ${report}")
+endif ()
+message(STATUS "cspan_codegen_check: probes are straight-line, ${backward} backward branch(es) outside them")